@@ -1,5 +1,8 @@
 #include "base.h"
+#include "simd.h"
+#include "altruct/concurrency/parallel.h"
 #include <algorithm>
+#include <vector>
 
 namespace altruct {
 namespace math {
@@ -42,23 +45,105 @@ template<typename T>
 void slow_cyclic_convolution(T* r, T* f, T* g, int n) {
     slow_k_convolution(r, f, g, n, [&](int i, int j){ return (i + j) % n; });
 }
+template<typename T>
+void slow_subset_convolution(T* r, T* f, T* g, int log_n) {
+    for (int k = 0; k < (1 << log_n); k++) {
+        for (int i = k; ; i = (i - 1) & k) {
+            r[k] += f[i] * g[k ^ i];
+            if (i == 0) break;
+        }
+    }
+}
+
+/**
+ * The size in bytes of the blocks `fast_radix2_dif_transform` is performed on;
+ * should fit in the L2 cache.
+ */
+inline int& fast_radix2_block_bytes() {
+    static int block_bytes = 1 << 18;
+    return block_bytes;
+}
+
+/**
+ * Fast Radix-2 Decimation-in-Frequency Transform on butterfly rows.
+ *
+ * `rows(u, v, len)` performs the butterflies between `u[j]` and `v[j]` for `0 <= j < len`.
+ *
+ * Arrays larger than `fast_radix2_block_bytes()` are viewed as a matrix whose rows are blocks:
+ * the stages that combine elements of different blocks are done on panels of adjacent columns,
+ * the remaining stages are done block by block; so that both fit in the cache.
+ * Panels and blocks are processed on `concurrency::default_num_threads()` threads,
+ * hence `rows` must be safe to be called concurrently on disjoint data.
+ */
+template <typename T, typename ROWS>
+void fast_radix2_dif_rows(T *f, int log_n, ROWS rows) {
+    int log_b = 0; while ((sizeof(T) << (log_b + 1)) <= size_t(fast_radix2_block_bytes())) log_b++;
+    if (log_n <= log_b) {
+        const int n = 1 << log_n;
+        for (int log_m = log_n; log_m >= 1; --log_m) {
+            const int m = 1 << log_m, mh = m >> 1;
+            for (int i = 0; i < n; i += m) {
+                rows(f + i, f + i + mh, mh);
+            }
+        }
+        return;
+    }
+    const int B = 1 << log_b, R = 1 << (log_n - log_b), W = std::min(B, std::max(16, B / R));
+    concurrency::parallel_range(0, B / W, [&](int b, int e) {
+        for (int c0 = b * W; c0 < e * W; c0 += W) {
+            for (int hr = R / 2; hr >= 1; hr /= 2) {
+                for (int r0 = 0; r0 < R; r0 += hr * 2) {
+                    for (int r = r0; r < r0 + hr; r++) {
+                        rows(f + r * B + c0, f + (r + hr) * B + c0, W);
+                    }
+                }
+            }
+        }
+    });
+    concurrency::parallel_range(0, R, [&](int b, int e) {
+        for (int r = b; r < e; r++) {
+            fast_radix2_dif_rows(f + r * B, log_b, rows);
+        }
+    });
+}
 
 /**
  * Fast Radix-2 Decimation-in-Frequency Transform.
+ *
+ * `tr(u, v)` performs a single butterfly; see `fast_radix2_dif_rows`.
  */
 template <typename T, typename F>
 void fast_radix2_dif_transform(T *f, int log_n, F tr) {
-    const int n = 1 << log_n;
-    for (int log_m = log_n; log_m >= 1; --log_m) {
-        const int m = 1 << log_m, mh = m >> 1;
-        for (int i = 0; i < n; i += m) {
-            int k1 = i, k2 = i + mh;
-            for (int j = 0; j < mh; ++j, ++k1, ++k2) {
-                tr(f[k1], f[k2]);
-            }
-        }
-    }
-}
+    fast_radix2_dif_rows(f, log_n, [&](T* u, T* v, int len) {
+        for (int j = 0; j < len; ++j) {
+            tr(u[j], v[j]);
+        }
+    });
+}
+
+/**
+ * Fast Radix-2 Decimation-in-Frequency Transform.
+ *
+ * Same as above, with the rows of at least 8 butterflies vectorized
+ * for the modulo types supported by `simd_modulo_traits`.
+ *
+ * @param kind - the butterfly performed by `tr`
+ */
+template <typename T, typename F>
+void fast_radix2_dif_transform(T *f, int log_n, F tr, simd_butterfly::type kind) {
+    if (!simd_modulo_traits<T>::supported || !simd_enabled()) {
+        return fast_radix2_dif_transform(f, log_n, tr);
+    }
+    const uint32_t M = simd_modulo_traits<T>::M();
+    fast_radix2_dif_rows(f, log_n, [&](T* u, T* v, int len) {
+        uint32_t* raw_u = reinterpret_cast<uint32_t*>(u);
+        uint32_t* raw_v = reinterpret_cast<uint32_t*>(v);
+        if (simd_mod_radix2_rows(raw_u, raw_v, len, M, kind)) return;
+        for (int j = 0; j < len; ++j) {
+            tr(u[j], v[j]);
+        }
+    });
+}
 
 /**
  * Fast Walsh�Hadamard Transform.
@@ -68,7 +153,7 @@ void fast_walsh_hadamard_transform(T* f, int log_n) {
     fast_radix2_dif_transform(f, log_n, [](T& u, T& v){
         // (u, v) <-- (u + v, u - v)
         T t = u - v; u += v; v = t;
-    });
+    }, simd_butterfly::HADAMARD);
 }
 
 /**
@@ -79,7 +164,7 @@ void fast_arith_transform_plus(T *f, int log_n) {
     fast_radix2_dif_transform(f, log_n, [](T& u, T& v){
         // (u, v) <-- (u, v + u)
         v += u;
-    });
+    }, simd_butterfly::PLUS);
 }
 
 /**
@@ -90,7 +175,7 @@ void fast_arith_transform_minus(T *f, int log_n) {
     fast_radix2_dif_transform(f, log_n, [](T& u, T& v){
         // (u, v) <-- (u, v - u)
         v -= u;
-    });
+    }, simd_butterfly::MINUS);
 }
 
 /**
@@ -148,6 +233,59 @@ void xor_convolution(T* r, T* f, T* g, int log_n) {
     for (int k = 0; k < n; ++k) r[k] /= n;
 }
 
+/**
+ * Subset convolution:
+ *   r[k] = Sum[f[i] * g[j], k == i or j, 0 == i and j]
+ *
+ * Ranked zeta transform: the elements of each rank (the number of set bits)
+ * are transformed separately, multiplied as polynomials in rank and transformed
+ * back, keeping only the rank of `k` for each `k`; O(log_n^2 2^log_n).
+ * The products are computed on `concurrency::default_num_threads()` threads
+ * once the ranked arrays are larger than `fast_radix2_block_bytes()`.
+ *
+ * Note: neither `f` nor `g` are modified.
+ * It is allowed for `f`, `g` and `r` to be the same array.
+ *
+ * @param log_n - base-2 logarithm of the array length
+ */
+template<typename T>
+void subset_convolution(T* r, const T* f, const T* g, int log_n) {
+    const int n = 1 << log_n, L = log_n + 1;
+    T e0 = zeroT<T>::of(*f);
+    std::vector<int> rank(n);
+    for (int k = 1; k < n; ++k) rank[k] = rank[k >> 1] + (k & 1);
+    // `fr[i * n + k]` is `f[k]` if `i == rank[k]`, zero otherwise
+    std::vector<T> fr(L * n, e0), gr;
+    for (int k = 0; k < n; ++k) fr[rank[k] * n + k] = f[k];
+    for (int i = 0; i < L; ++i) fast_arith_transform_plus(&fr[i * n], log_n);
+    if (g != f) {
+        gr.assign(L * n, e0);
+        for (int k = 0; k < n; ++k) gr[rank[k] * n + k] = g[k];
+        for (int i = 0; i < L; ++i) fast_arith_transform_plus(&gr[i * n], log_n);
+    }
+    const std::vector<T>& gt = (g != f) ? gr : fr;
+    // the product in rank, inplace from the highest rank down;
+    // the transforms at `k` are zero in the ranks higher than `rank[k]`
+    auto mul_ranks = [&](int b, int e) {
+        for (int k = b; k < e; ++k) {
+            for (int i = L - 1; i >= 0; --i) {
+                T t = e0;
+                int j0 = std::max(0, i - rank[k]), j1 = std::min(i, rank[k]);
+                for (int j = j0; j <= j1; ++j) t += fr[j * n + k] * gt[(i - j) * n + k];
+                fr[i * n + k] = t;
+            }
+        }
+    };
+    // threads only pay off once the ranked arrays no longer fit in the cache
+    if (sizeof(T) * L * n <= size_t(fast_radix2_block_bytes())) {
+        mul_ranks(0, n);
+    } else {
+        concurrency::parallel_range(0, n, mul_ranks);
+    }
+    for (int i = 0; i < L; ++i) fast_arith_transform_minus(&fr[i * n], log_n);
+    for (int k = 0; k < n; ++k) r[k] = fr[rank[k] * n + k];
+}
+
 /**
  * Max-convolution:
  *   r[k] = Sum[f[i] * g[j], k == max(i, j)]
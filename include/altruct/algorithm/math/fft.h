@@ -1,6 +1,7 @@
 #pragma once
 
 #include "base.h"
+#include <algorithm>
 #include <iterator>
 #include <vector>
 
@@ -60,6 +61,23 @@ void fft_rec(T *dest, T *src, int size, const R& root, int off = 1) {
     }
 }
 
+/**
+ * Spectra of two real sequences packed into a single complex sequence
+ *
+ * Given `zk = Z[k]` and `zl = Z[-k mod size]` of the spectrum `Z` of `z = x + i y`,
+ * where `x` and `y` are real, computes `X[k]` and `Y[k]` by the conjugate symmetry:
+ *   X[k] = (Z[k] + conj(Z[-k])) / 2
+ *   Y[k] = (Z[k] - conj(Z[-k])) / 2i
+ * Note that `X[-k] = conj(X[k])` and `Y[-k] = conj(Y[k])`.
+ *
+ * @param C - the complex type, e.g. `complex<double>`
+ */
+template<typename C>
+void fft_unpack_real(const C& zk, const C& zl, C* xk, C* yk) {
+    *xk = C((zk.a + zl.a) / 2, (zk.b - zl.b) / 2);
+    *yk = C((zk.b + zl.b) / 2, (zl.a - zk.a) / 2);
+}
+
 /**
  * FFT Cyclic Convolution of two sequences
  *
@@ -128,6 +146,9 @@ std::vector<T> convolution(It u_begin, It u_end, It v_begin, It v_end, const R&
  * Note, `u` is the kernel and `v` is the cyclic list.
  * Mathematica equivalent: `ListConvolve[u, v, {1, -1}]`
  *
+ * The kernel is first folded modulo `v_size`, so that the transform size is
+ * the power of two not less than `v_size + min(u_size, v_size) - 1`.
+ *
  * @param u_begin, u_end - iterators of sequence u; u_size = u_end - u_begin
  * @param v_begin, v_end - iterators of sequence v; v_size = v_end - v_begin
  * @param root_base - a principal k-th root of unity in the ring T
@@ -137,20 +158,62 @@ std::vector<T> convolution(It u_begin, It u_end, It v_begin, It v_end, const R&
 template<typename T, typename R, typename It>
 std::vector<T> cyclic_convolution(It u_begin, It u_end, It v_begin, It v_end, const R& root_base, int root_order) {
     R e1 = identityT<R>::of(root_base); T e0 = zeroT<T>::of(T(e1));
-    std::vector<T> r, u(u_begin, u_end), v(v_begin, v_end);
-    int u_size = (int)u.size(), v_size = (int)v.size();
-    int vv_size = multiple(v_size, u_size);
+    std::vector<T> r, v(v_begin, v_end);
+    int u_size = 0, v_size = (int)v.size();
+    std::vector<T> u(v_size, e0);
+    for (It it = u_begin; it != u_end; ++it, u_size++) u[u_size % v_size] += *it;
+    int w_size = std::min(u_size, v_size);
     int n = v_size + u_size - 1;
-    int nn = vv_size + u_size - 1;
-    int l = 1; while (l < nn) l *= 2;
+    int l = 1; while (l < v_size + w_size - 1) l *= 2;
     r.resize(l, e0); u.resize(l, e0); v.resize(l, e0);
-    for (int i = v_size; i < vv_size; i++) v[i] = v[i - v_size];
-    for (int i = 1; i < u_size; i++) v[l - i] = v[vv_size - i];
     fft_cyclic_convolution(&r[0], &u[0], &v[0], l, root_base, root_order);
-    for (int i = 1; i < u_size; i++) r[n - i] = r[u_size - 1 - i];
+    for (int i = v_size; i < v_size + w_size - 1; i++) r[i - v_size] += r[i];
     r.resize(n);
+    for (int i = v_size; i < n; i++) r[i] = r[i - v_size];
     return r;
 }
 
+/**
+ * Chirp-z Transform (Bluestein's algorithm)
+ *
+ * dest[k] = Sum[src[j] * z^(j k), {j, 0, n - 1}], for k in [0, m)
+ *
+ * I.e. evaluates the polynomial `src` at the geometric progression `z^k`.
+ * For `z` a principal n-th root of unity and `m = n`, this is the DFT of an
+ * arbitrary length `n`, not necessarily a power of two; and for `z = root^-1`
+ * its inverse, up to the factor `n`.
+ *
+ * By `j k = t(j + k) - t(j) - t(k)`, where `t(i) = i (i - 1) / 2`, the transform
+ * reduces to a single correlation with the chirp `z^t(i)`, done by a cyclic
+ * convolution of the power of two size not less than `n + m - 1`.
+ * Only `z` has to be invertible, no square root of it is needed.
+ *
+ * @param dest - destination array of length `m` for result
+ * @param src - source data to transform, array of length `n`
+ * @param z - the ratio of the progression
+ * @param root_base - a principal k-th root of unity in the ring T
+ * @param root_order - order `k` of the root, must be a power of 2 not less than `n + m - 1`
+ */
+template<typename T, typename R>
+void chirp_z(T* dest, int m, const T* src, int n, const T& z, const R& root_base, int root_order) {
+    R e1r = identityT<R>::of(root_base);
+    T e1 = T(e1r), e0 = zeroT<T>::of(e1);
+    int l = 1; while (l < n + m - 1) l *= 2;
+    std::vector<T> a(l, e0), b(l, e0), c(l, e0);
+    // b[i] = z^t(i), and z^-t(i) for the twisting of the input and the output
+    T zi = e1, izi = e1, iz = e1 / z, w = e1, iw = e1;
+    std::vector<T> iwv(std::max(n, m));
+    for (int i = 0; i < n + m - 1; i++) {
+        b[i] = w;
+        if (i < (int)iwv.size()) iwv[i] = iw;
+        w *= zi, zi *= z;
+        iw *= izi, izi *= iz;
+    }
+    // a is reversed, so that the correlation becomes a convolution
+    for (int j = 0; j < n; j++) a[n - 1 - j] = src[j] * iwv[j];
+    fft_cyclic_convolution(&c[0], &a[0], &b[0], l, root_base, root_order);
+    for (int k = 0; k < m; k++) dest[k] = c[n - 1 + k] * iwv[k];
+}
+
 } // math
 } // altruct
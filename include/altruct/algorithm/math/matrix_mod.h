@@ -0,0 +1,142 @@
+#pragma once
+
+#include "altruct/concurrency/parallel.h"
+#include "altruct/structure/math/matrix.h"
+#include "altruct/structure/math/modulo.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace altruct {
+namespace math {
+
+/**
+ * matrix<modulo<int>> multiplication
+ *
+ * Shared by the `CONSTANT`, `STATIC` and `MONTGOMERY` specializations below.
+ * Dispatches through `matrix_mul<mod>` so that a specialization
+ * can replace any of the individual implementations.
+ *
+ * The operands are packed into contiguous arrays of the raw residues, and the
+ * products are accumulated in 64 bits without reduction. A multiple of `M` is
+ * subtracted once per block of `K` products, the most that can not overflow, and
+ * the sums are reduced once at the end. The columns are processed in blocks of
+ * `block_cols()`, so that the accumulators stay in L1 and the strip of `m2` in L2.
+ * From `parallel_threshold()` multiply-adds on, the rows of the result are split
+ * across `concurrency::default_num_threads()` threads. Each element is computed
+ * by one thread the same way, so the result does not depend on the thread count.
+ */
+template<typename mod>
+struct matrix_mul_modulo_int {
+    typedef matrix_mul<mod> mm;
+
+    // the raw residue of `x` in `[0, M)`, and the element of a reduced sum of raw products
+    static uint32_t raw(const mod& x) { return uint32_t(x.v); }
+    static mod from_raw(uint32_t r) { return mod(int(r)); }
+
+    // the number of columns processed at once
+    static int& block_cols() { static int cols = 256; return cols; }
+
+    // the number of multiply-adds, `n * m * p`, from which the rows are processed in parallel
+    static int64_t& parallel_threshold() { static int64_t threshold = int64_t(1) << 21; return threshold; }
+
+    // r[i * p + j] = Sum[a[i * m + k] * b[k * p + j], {k, 0, m - 1}] mod M, for `a`, `b` in `[0, M)`
+    static void _mul_blocked(uint32_t* r, const uint32_t* a, const uint32_t* b, int n, int m, int p, uint32_t M) {
+        // `acc < 2^63 + M` holds after each subtraction of `S`, and `K` products keep it below `2^64`
+        uint64_t M2 = uint64_t(M - 1) * (M - 1);
+        uint64_t H = uint64_t(1) << 63, S = H / M * M;
+        int K = (M2 == 0) ? m : int(std::min<uint64_t>(m, (H - M) / M2));
+        int jb = std::max(block_cols(), 1);
+        std::vector<uint64_t> acc(std::min(jb, p));
+        for (int j0 = 0; j0 < p; j0 += jb) {
+            int jn = std::min(jb, p - j0);
+            for (int i = 0; i < n; i++) {
+                uint64_t* c = acc.data();
+                std::fill(c, c + jn, 0);
+                const uint32_t* ai = a + int64_t(i) * m;
+                for (int k0 = 0; k0 < m; k0 += K) {
+                    int k1 = std::min(m, k0 + K);
+                    for (int k = k0; k < k1; k++) {
+                        uint64_t x = ai[k];
+                        const uint32_t* bk = b + int64_t(k) * p + j0;
+                        for (int j = 0; j < jn; j++) c[j] += x * bk[j];
+                    }
+                    for (int j = 0; j < jn; j++) c[j] = (c[j] >= S) ? c[j] - S : c[j];
+                }
+                uint32_t* ri = r + int64_t(i) * p + j0;
+                for (int j = 0; j < jn; j++) ri[j] = uint32_t(c[j] % M);
+            }
+        }
+    }
+
+    // the raw residues of `m1`, row by row
+    static std::vector<uint32_t> pack(const matrix<mod>& m1) {
+        int n = m1.rows(), m = m1.cols();
+        std::vector<uint32_t> v(int64_t(n) * m);
+        for (int i = 0; i < n; i++) {
+            for (int j = 0; j < m; j++) {
+                v[int64_t(i) * m + j] = mm::raw(m1[i][j]);
+            }
+        }
+        return v;
+    }
+
+    static void _mul_packed(matrix<mod>& mr, const matrix<mod>& m1, const matrix<mod>& m2) {
+        int n = m1.rows(), m = m1.cols(), p = m2.cols();
+        auto a = pack(m1);
+        // a square is packed only once
+        std::vector<uint32_t> b2;
+        if (&m1 != &m2) b2 = pack(m2);
+        const std::vector<uint32_t>& b = (&m1 != &m2) ? b2 : a;
+        std::vector<uint32_t> r(int64_t(n) * p);
+        uint32_t M = uint32_t(mod::M());
+        auto mul_rows = [&](int i0, int i1) {
+            mm::_mul_blocked(r.data() + int64_t(i0) * p, a.data() + int64_t(i0) * m, b.data(), i1 - i0, m, p, M);
+        };
+        if (int64_t(n) * m * p < mm::parallel_threshold()) {
+            mul_rows(0, n);
+        } else {
+            concurrency::parallel_range(0, n, mul_rows);
+        }
+        for (int i = 0; i < n; i++) {
+            for (int j = 0; j < p; j++) {
+                mr[i][j] = mm::from_raw(r[int64_t(i) * p + j]);
+            }
+        }
+    }
+
+    static void impl(matrix<mod>& mr, const matrix<mod>& m1, const matrix<mod>& m2) {
+        int n = m1.rows(), m = m1.cols(), p = m2.cols();
+        if (std::min(std::min(n, m), p) < 8) {
+            matrix<mod>::_mul_long(mr, m1, m2);
+        } else {
+            _mul_packed(mr, m1, m2);
+        }
+    }
+};
+
+/**
+ * matrix<modulo<int>> specializations
+ */
+template<int ID>
+struct matrix_mul<modulo<int, ID, modulo_storage::CONSTANT>> : matrix_mul_modulo_int<modulo<int, ID, modulo_storage::CONSTANT>> {};
+template<int ID>
+struct matrix_mul<modulo<int, ID, modulo_storage::STATIC>> : matrix_mul_modulo_int<modulo<int, ID, modulo_storage::STATIC>> {};
+
+/**
+ * matrix<modulo<int>> specialization for the Montgomery form
+ *
+ * The raw residues are the Montgomery forms `x R`, so a reduced sum of
+ * raw products is `x y R^2`, and a single Montgomery reduction gives the
+ * Montgomery form of the result.
+ */
+template<int ID>
+struct matrix_mul<modulo<int, ID, modulo_storage::MONTGOMERY>> : matrix_mul_modulo_int<modulo<int, ID, modulo_storage::MONTGOMERY>> {
+    typedef modulo<int, ID, modulo_storage::MONTGOMERY> mod;
+    static uint32_t raw(const mod& x) { return x.v.r; }
+    static mod from_raw(uint32_t r) { return mod::from_montgomery(mod::mg().from(r)); }
+};
+
+} // math
+} // altruct
@@ -0,0 +1,402 @@
+#pragma once
+
+#include "base.h"
+#include "simd.h"
+#include "altruct/concurrency/parallel.h"
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace altruct {
+namespace math {
+
+/**
+ * Montgomery form copies of the twiddle tables for the vectorized stages;
+ * built along with the tables of `ntt_roots` if the CPU supports them.
+ * Empty for the modulo types not supported by `simd_modulo_traits`.
+ */
+template<typename T, bool = simd_modulo_traits<T>::supported>
+struct ntt_simd_twiddles {
+    void assign(const std::vector<T>& roots, const std::vector<T>& iroots) {}
+};
+template<typename T>
+struct ntt_simd_twiddles<T, true> {
+    simd_ntt_twiddles tw;
+    void assign(const std::vector<T>& roots, const std::vector<T>& iroots) {
+        uint32_t M = simd_modulo_traits<T>::M();
+        if (!cpu_has_avx2() || M % 2 == 0) return;
+        tw.assign(M, roots, iroots);
+    }
+    // the twiddles, if built for the current modulus
+    const simd_ntt_twiddles* get() const { return (tw.M != 0 && tw.M == simd_modulo_traits<T>::M()) ? &tw : nullptr; }
+};
+
+/**
+ * Twiddle tables for the Number Theoretic Transform over a prime modulus.
+ *
+ * Tables are laid out so that the same table serves all sizes up to its own:
+ *   `roots[h + j] = w(2h)^j` and `iroots[h + j] = w(2h)^-j`,
+ *   for each power of two `h < size` and `0 <= j < h`,
+ * where `w(k)` is a principal k-th root of unity.
+ *
+ * @param T - the modulo type, e.g. `modulo<int, 998244353, modulo_storage::CONSTANT>`
+ */
+template<typename T>
+class ntt_roots {
+public:
+    T e1;                   // multiplicative identity; carries the modulus
+    T root;                 // principal 2^max_log-th root of unity
+    int max_log;            // largest `k` such that 2^k divides `M - 1`
+    std::vector<T> roots;   // roots[h + j] = w(2h)^j
+    std::vector<T> iroots;  // iroots[h + j] = w(2h)^-j
+    ntt_simd_twiddles<T> simd_twiddles; // `roots` and `iroots` for the vectorized stages
+
+    // Finds a principal root of unity of the largest power of two order.
+    // `M` is assumed to be a prime; `max_log` is 0 if no root is found.
+    ntt_roots(const T& e1) : e1(e1), root(e1), max_log(0) {
+        auto m1 = e1.M() - 1;
+        int k = 0;
+        while (m1 > 0 && m1 % 2 == 0) m1 /= 2, k++;
+        for (int g = 2; g < 1000 && k > 0; g++) {
+            T w = powT(castOf(e1, g), m1), t = w;
+            for (int i = 1; i < k; i++) t *= t;
+            if (t == -e1) { root = w, max_log = k; break; }
+        }
+        roots.assign(2, e1);
+        iroots.assign(2, e1);
+        simd_twiddles.assign(roots, iroots);
+    }
+
+    // the largest transform size supported by the modulus
+    int max_size() const { return 1 << max_log; }
+
+    // extends the tables to support transforms of length `size`
+    void reserve(int size) {
+        if (size <= (int)roots.size()) return;
+        int l = max_log; T w = root;
+        for (; (1 << l) > size; l--) w *= w;
+        T iw = e1 / w;
+        roots.resize(size);
+        iroots.resize(size);
+        int h = size / 2;
+        roots[h] = iroots[h] = e1;
+        for (int j = 1; j < h; j++) {
+            roots[h + j] = roots[h + j - 1] * w;
+            iroots[h + j] = iroots[h + j - 1] * iw;
+        }
+        for (h /= 2; h >= 1; h /= 2) {
+            for (int j = 0; j < h; j++) {
+                roots[h + j] = roots[h * 2 + j * 2];
+                iroots[h + j] = iroots[h * 2 + j * 2];
+            }
+        }
+        roots[0] = iroots[0] = e1;
+        simd_twiddles.assign(roots, iroots);
+    }
+
+    // Returns the cached tables for the modulus of `e1`, reserved for at least `size` elements.
+    // Tables are cached per type `T` and per modulus. A cached table is never modified,
+    // and a larger one is built if needed, so the returned reference stays valid
+    // and can be used from several threads. This function is thread-safe.
+    // `size` must be a power of two not greater than `max_size()`.
+    static const ntt_roots& get(const T& e1, int size = 1) {
+        // keyed by the modulus, since a `STATIC` modulus of the cached `e1` may have changed since
+        typedef typename std::decay<decltype(e1.M())>::type modulus_t;
+        static std::mutex mutex;
+        static std::vector<std::pair<modulus_t, std::unique_ptr<ntt_roots>>> cache;
+        std::lock_guard<std::mutex> lock(mutex);
+        modulus_t M = e1.M();
+        // the last table of a modulus is the largest one
+        for (auto it = cache.rbegin(); it != cache.rend(); ++it) {
+            if (!(it->first == M)) continue;
+            const ntt_roots& tbl = *it->second;
+            if (std::max(4, std::min(size, tbl.max_size())) <= (int)tbl.roots.size()) return tbl;
+            break;
+        }
+        std::unique_ptr<ntt_roots> tbl(new ntt_roots(e1));
+        tbl->reserve(std::max(4, std::min(size, tbl->max_size())));
+        cache.emplace_back(M, std::move(tbl));
+        return *cache.back().second;
+    }
+};
+
+/**
+ * Vectorized stages of `ntt_dif` and `ntt_dit`
+ *
+ * Each stage returns false if it is not vectorized and has to be done by the scalar code.
+ * Modulo types supported by `simd_modulo_traits` use the Montgomery form twiddles of `tbl`.
+ * `dif2_rows` and `dit2_rows` are the radix-2 butterflies between the rows `u` and `v`
+ * of `n` elements each, with the twiddles `roots[k + j]` and `iroots[k + j]` respectively.
+ */
+template<typename T, bool = simd_modulo_traits<T>::supported>
+struct ntt_simd {
+    ntt_simd(const ntt_roots<T>& tbl) {}
+    bool dif2(T* data, int h) const { return false; }
+    bool dif4(T* data, int size, int q) const { return false; }
+    bool dit4(T* data, int size, int q) const { return false; }
+    bool dit2(T* data, int h) const { return false; }
+    bool dif2_rows(T* u, T* v, int n, int k) const { return false; }
+    bool dit2_rows(T* u, T* v, int n, int k) const { return false; }
+};
+template<typename T>
+struct ntt_simd<T, true> {
+    const simd_ntt_twiddles* tw;
+    ntt_simd(const ntt_roots<T>& tbl) : tw(simd_enabled() ? tbl.simd_twiddles.get() : nullptr) {}
+    static uint32_t* raw(T* data) { return reinterpret_cast<uint32_t*>(data); }
+    bool dif2(T* data, int h) const { return tw && simd_ntt_dif2_stage(raw(data), h, *tw); }
+    bool dif4(T* data, int size, int q) const { return tw && simd_ntt_dif4_stage(raw(data), size, q, *tw); }
+    bool dit4(T* data, int size, int q) const { return tw && simd_ntt_dit4_stage(raw(data), size, q, *tw); }
+    bool dit2(T* data, int h) const { return tw && simd_ntt_dit2_stage(raw(data), h, *tw); }
+    bool dif2_rows(T* u, T* v, int n, int k) const { return tw && simd_ntt_dif2_rows(raw(u), raw(v), n, k, *tw); }
+    bool dit2_rows(T* u, T* v, int n, int k) const { return tw && simd_ntt_dit2_rows(raw(u), raw(v), n, k, *tw); }
+};
+
+/**
+ * Transforms of at least this size are done by `ntt_dif_four_step` and `ntt_dit_four_step`.
+ * Smaller transforms fit in the L2 cache and are too short for threading to pay off.
+ */
+inline int& ntt_four_step_threshold() {
+    static int threshold = 1 << 20;
+    return threshold;
+}
+
+template<typename T> void ntt_dif_four_step(T* data, int size, const ntt_roots<T>& tbl);
+template<typename T> void ntt_dit_four_step(T* data, int size, const ntt_roots<T>& tbl);
+
+/**
+ * Inplace iterative radix-4 Decimation-in-Frequency Number Theoretic Transform
+ *
+ * Input is in the natural order, output is in the bit-reversed order.
+ * A single radix-2 stage is performed first if `size` is not a power of 4.
+ * Sizes of at least `ntt_four_step_threshold()` are done by `ntt_dif_four_step`.
+ *
+ * @param data - data to transform, array of length `size`
+ * @param size - number of elements, must be a power of two
+ * @param tbl - twiddle tables reserved for at least `size` elements
+ */
+template<typename T>
+void ntt_dif(T* data, int size, const ntt_roots<T>& tbl) {
+    if (size >= std::max(4, ntt_four_step_threshold())) return ntt_dif_four_step(data, size, tbl);
+    const T* roots = tbl.roots.data();
+    const ntt_simd<T> simd(tbl);
+    int log_n = 0; while ((1 << log_n) < size) log_n++;
+    int h = size / 2;
+    if (log_n % 2 == 1) {
+        if (!simd.dif2(data, h)) {
+            for (int j = 0; j < h; j++) {
+                T u = data[j], v = data[j + h];
+                data[j] = u + v;
+                data[j + h] = (u - v) * roots[h + j];
+            }
+        }
+        h /= 2;
+    }
+    for (int q = h / 2; q >= 1; q /= 4) {
+        if (simd.dif4(data, size, q)) continue;
+        const T I = roots[3];
+        for (T* a = data; a < data + size; a += q * 4) {
+            for (int j = 0; j < q; j++) {
+                T w1 = roots[q * 2 + j], w2 = roots[q + j], w3 = w1 * w2;
+                T a0 = a[j], a1 = a[j + q], a2 = a[j + q * 2], a3 = a[j + q * 3];
+                T b0 = a0 + a2, b1 = a1 + a3, x = a0 - a2, y = (a1 - a3) * I;
+                a[j] = b0 + b1;
+                a[j + q] = (b0 - b1) * w2;
+                a[j + q * 2] = (x + y) * w1;
+                a[j + q * 3] = (x - y) * w3;
+            }
+        }
+    }
+}
+
+/**
+ * Inplace iterative radix-4 Decimation-in-Time inverse Number Theoretic Transform
+ *
+ * Input is in the bit-reversed order, output is in the natural order.
+ * This is the exact inverse of `ntt_dif`, except that the result
+ * is not divided by `size`.
+ * Sizes of at least `ntt_four_step_threshold()` are done by `ntt_dit_four_step`.
+ *
+ * @param data - data to transform, array of length `size`
+ * @param size - number of elements, must be a power of two
+ * @param tbl - twiddle tables reserved for at least `size` elements
+ */
+template<typename T>
+void ntt_dit(T* data, int size, const ntt_roots<T>& tbl) {
+    if (size >= std::max(4, ntt_four_step_threshold())) return ntt_dit_four_step(data, size, tbl);
+    const T* iroots = tbl.iroots.data();
+    const ntt_simd<T> simd(tbl);
+    int log_n = 0; while ((1 << log_n) < size) log_n++;
+    int h = size / 2;
+    for (int q = 1; q * 4 <= ((log_n % 2 == 1) ? h : size); q *= 4) {
+        if (simd.dit4(data, size, q)) continue;
+        const T iI = iroots[3];
+        for (T* a = data; a < data + size; a += q * 4) {
+            for (int j = 0; j < q; j++) {
+                T iw1 = iroots[q * 2 + j], iw2 = iroots[q + j], iw3 = iw1 * iw2;
+                T c0 = a[j], c1 = a[j + q] * iw2, c2 = a[j + q * 2] * iw1, c3 = a[j + q * 3] * iw3;
+                T p = c0 + c1, q1 = c0 - c1, r = c2 + c3, s = (c2 - c3) * iI;
+                a[j] = p + r;
+                a[j + q] = q1 + s;
+                a[j + q * 2] = p - r;
+                a[j + q * 3] = q1 - s;
+            }
+        }
+    }
+    if (log_n % 2 == 1 && !simd.dit2(data, h)) {
+        for (int j = 0; j < h; j++) {
+            T u = data[j], v = data[j + h] * iroots[h + j];
+            data[j] = u + v;
+            data[j + h] = u - v;
+        }
+    }
+}
+
+/**
+ * Four-step Number Theoretic Transform
+ *
+ * The array is viewed as a `rows x cols` matrix, `data[r * cols + c]`, with
+ * both dimensions about `sqrt(size)`. The first `log2(rows)` stages of `ntt_dif`
+ * only combine the elements of the same column, while the remaining stages
+ * are exactly `ntt_dif` of each row. Hence:
+ *   1. the first stages are done on panels of `panel` adjacent columns,
+ *      each panel being copied into a buffer that fits in the L2 cache,
+ *   2. each row is transformed by `ntt_dif`.
+ * The result is exactly that of `ntt_dif`, but each element is streamed
+ * through the memory only a few times, regardless of `size`.
+ * Panels and rows are processed on `concurrency::default_num_threads()` threads.
+ * `ntt_dit_four_step` does the inverse steps in the reverse order.
+ */
+struct ntt_four_step_layout {
+    int rows, cols, panel;
+    ntt_four_step_layout(int size) {
+        int log_n = 0; while ((1 << log_n) < size) log_n++;
+        rows = 1 << (log_n / 2);
+        cols = size / rows;
+        panel = std::min(cols, std::max(16, (1 << 16) / rows));
+    }
+};
+
+// the first `log2(rows)` stages of `ntt_dif` if `forward`, the last stages of `ntt_dit` otherwise,
+// on the panels `[b, e)`
+template<typename T>
+void ntt_four_step_panels(T* data, int b, int e, const ntt_four_step_layout& lay, const ntt_roots<T>& tbl, bool forward) {
+    const ntt_simd<T> simd(tbl);
+    int R = lay.rows, C = lay.cols, W = lay.panel;
+    std::vector<T> buf(R * W, tbl.e1);
+    for (int c0 = b * W; c0 < e * W; c0 += W) {
+        for (int r = 0; r < R; r++) {
+            std::copy(data + r * C + c0, data + r * C + c0 + W, &buf[r * W]);
+        }
+        for (int hr = forward ? R / 2 : 1; 1 <= hr && hr < R; hr = forward ? hr / 2 : hr * 2) {
+            for (int r0 = 0; r0 < R; r0 += hr * 2) {
+                for (int r = r0; r < r0 + hr; r++) {
+                    // the stage of the whole transform with the half-length `h = hr * C`
+                    int k = hr * C + (r - r0) * C + c0;
+                    T* u = &buf[r * W];
+                    T* v = &buf[(r + hr) * W];
+                    if (forward) {
+                        if (simd.dif2_rows(u, v, W, k)) continue;
+                        for (int w = 0; w < W; w++) {
+                            T x = u[w], y = v[w];
+                            u[w] = x + y;
+                            v[w] = (x - y) * tbl.roots[k + w];
+                        }
+                    } else {
+                        if (simd.dit2_rows(u, v, W, k)) continue;
+                        for (int w = 0; w < W; w++) {
+                            T x = u[w], y = v[w] * tbl.iroots[k + w];
+                            u[w] = x + y;
+                            v[w] = x - y;
+                        }
+                    }
+                }
+            }
+        }
+        for (int r = 0; r < R; r++) {
+            std::copy(&buf[r * W], &buf[r * W] + W, data + r * C + c0);
+        }
+    }
+}
+
+/**
+ * Four-step variant of `ntt_dif`; see `ntt_four_step_layout`.
+ */
+template<typename T>
+void ntt_dif_four_step(T* data, int size, const ntt_roots<T>& tbl) {
+    ntt_four_step_layout lay(size);
+    int R = lay.rows, C = lay.cols;
+    concurrency::parallel_range(0, C / lay.panel, [&](int b, int e) {
+        ntt_four_step_panels(data, b, e, lay, tbl, true);
+    });
+    concurrency::parallel_range(0, R, [&](int b, int e) {
+        for (int r = b; r < e; r++) ntt_dif(data + r * C, C, tbl);
+    });
+}
+
+/**
+ * Four-step variant of `ntt_dit`; see `ntt_four_step_layout`.
+ */
+template<typename T>
+void ntt_dit_four_step(T* data, int size, const ntt_roots<T>& tbl) {
+    ntt_four_step_layout lay(size);
+    int R = lay.rows, C = lay.cols;
+    concurrency::parallel_range(0, R, [&](int b, int e) {
+        for (int r = b; r < e; r++) ntt_dit(data + r * C, C, tbl);
+    });
+    concurrency::parallel_range(0, C / lay.panel, [&](int b, int e) {
+        ntt_four_step_panels(data, b, e, lay, tbl, false);
+    });
+}
+
+/**
+ * NTT Cyclic Convolution of two sequences
+ *
+ * Result is stored in `dataR`. Both `data1` and `data2` are modified.
+ * dataR[k] = Sum[data1[i] * data2[(k - i) % size], {i, 0, size - 1}]
+ *
+ * It is allowed for `dataR`, `data1` and `data2` to be the same array.
+ *
+ * @param dataR - result, array of length `size`
+ * @param data1 - data1, array of length `size`
+ * @param data2 - data2, array of length `size`
+ * @param size - number of elements, must be a power of two not greater than `ntt_roots<T>::max_size()`
+ */
+template<typename T>
+void ntt_cyclic_convolution(T *dataR, T *data1, T *data2, int size) {
+    T e1 = identityOf(*data1);
+    const auto& tbl = ntt_roots<T>::get(e1, size);
+    ntt_dif(data1, size, tbl);
+    if (data2 != data1) ntt_dif(data2, size, tbl);
+    for (int i = 0; i < size; i++) dataR[i] = data1[i] * data2[i];
+    ntt_dit(dataR, size, tbl);
+    T isize = e1 / castOf(e1, size);
+    for (int i = 0; i < size; i++) dataR[i] *= isize;
+}
+
+/**
+ * NTT Ordinary Convolution of two sequences
+ *
+ * Mathematica equivalent: `ListConvolve[u, v, {1, -1}, 0]`
+ *
+ * @param u_begin, u_end - iterators of sequence u; u_size = u_end - u_begin
+ * @param v_begin, v_end - iterators of sequence v; v_size = v_end - v_begin
+ * @return - result, array of length size = u_size + v_size - 1
+ */
+template<typename T, typename It>
+std::vector<T> ntt_convolution(It u_begin, It u_end, It v_begin, It v_end) {
+    T e0 = zeroOf(T(*u_begin));
+    std::vector<T> u(u_begin, u_end), v(v_begin, v_end);
+    int n = (int)(u.size() + v.size() - 1);
+    int l = 1; while (l < n) l *= 2;
+    u.resize(l, e0); v.resize(l, e0);
+    ntt_cyclic_convolution(u.data(), u.data(), v.data(), l);
+    u.resize(n);
+    return u;
+}
+
+} // math
+} // altruct
@@ -0,0 +1,77 @@
+#pragma once
+
+#include "altruct/structure/math/polynom.h"
+
+#include <vector>
+
+namespace altruct {
+namespace math {
+
+/**
+ * Online (relaxed) convolution
+ *
+ * Computes `h = f * g` coefficient by coefficient, where `f[n]` and `g[n]`
+ * need only be known once `h[0]` through `h[n-1]` are, as is the case with
+ * recursively defined series. E.g. the Catalan numbers, `c = 1 + x c^2`:
+ *
+ *   online_convolution<T> oc; std::vector<T> c{ 1 };
+ *   for (int n = 1; n < N; n++) c.push_back(oc.push(c[n - 1], c[n - 1]));
+ *
+ * Besides `f[n] g[0] + f[0] g[n]`, the product of the blocks `f[s, 2s)` and
+ * `g[js, (j+1)s)`, and symmetrically of `f[js, (j+1)s)` and `g[s, 2s)` for `j >= 2`,
+ * is done as soon as both blocks are known, i.e. at `n = (j+1)s - 1`,
+ * and only contributes to `h[n+1]` and beyond; `s` being a power of two.
+ * O(M(n) log n) in total, where M(n) is the cost of `polynom<T>::mul`.
+ * The blocks `f[s, 2s)` and `g[s, 2s)` are prepared for multiplication once.
+ * Blocks smaller than 32 are multiplied directly.
+ */
+template<typename T>
+class online_convolution {
+public:
+    std::vector<T> f, g;        // the coefficients pushed so far
+    std::vector<T> h;           // h[0] through h[n-1] are final, the rest are partial sums
+    std::vector<polynom_operand<T>> fo, go; // f[s, 2s) and g[s, 2s), for `s = 2^(k+5)`
+
+    // the number of coefficients pushed so far
+    int size() const { return (int)f.size(); }
+
+    // pushes `f[n]` and `g[n]`, and returns `h[n]`, where `n = size()`
+    T push(const T& fn, const T& gn) {
+        int n = size();
+        f.push_back(fn), g.push_back(gn);
+        if ((int)h.size() < n * 2 + 1) h.resize(n * 2 + 1, zeroOf(fn));
+        h[n] += f[n] * g[0];
+        if (n > 0) h[n] += f[0] * g[n];
+        for (int k = 0, s = 1; (n + 1) % s == 0 && s * 2 <= n + 1; k++, s *= 2) {
+            int j = (n + 1) / s - 1;
+            if (s < 32) {
+                add_block(&f[s], &g[j * s], s, n + 1);
+                if (j >= 2) add_block(&f[j * s], &g[s], s, n + 1);
+                continue;
+            }
+            if (j == 1) {
+                fo.emplace_back(polynom<T>(f.begin() + s, f.begin() + s * 2), s - 1);
+                go.emplace_back(polynom<T>(g.begin() + s, g.begin() + s * 2), s - 1);
+            }
+            add_block(fo[k - 5], &g[j * s], s, n + 1);
+            if (j >= 2) add_block(go[k - 5], &f[j * s], s, n + 1);
+        }
+        return h[n];
+    }
+
+private:
+    // h[o, o + 2s - 1) += p1[0, s) * p2[0, s)
+    void add_block(const T* p1, const T* p2, int s, int o) {
+        std::vector<T> t(s * 2 - 1, zeroOf(*p1));
+        polynom<T>::_mul(t.data(), s * 2 - 2, p1, s - 1, p2, s - 1);
+        polynom<T>::_add_to(&h[o], t.data(), s * 2 - 2);
+    }
+    void add_block(const polynom_operand<T>& o1, const T* p2, int s, int o) {
+        polynom<T> t(p2, p2 + s);
+        polynom<T>::mul(t, t, o1, s * 2 - 2);
+        polynom<T>::_add_to(&h[o], t.c.data(), s * 2 - 2);
+    }
+};
+
+} // math
+} // altruct
@@ -0,0 +1,157 @@
+#pragma once
+
+#include "altruct/algorithm/math/fft.h"
+#include "altruct/structure/math/root_wrapper.h"
+#include "altruct/structure/math/complex.h"
+#include "altruct/structure/math/polynom.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace altruct {
+namespace math {
+
+/**
+ * An upper bound on the absolute error of each coefficient of a product
+ * computed by the complex FFT of size `n`, where `norm1` and `norm2`
+ * are the Euclidean norms of the factors' coefficients.
+ *
+ * This is Percival's bound for a forward transform of each factor and an inverse
+ * transform of the pointwise product, with the roots accurate to a unit roundoff:
+ *   |z' - z| <= |x| |y| ((1 + e)^3L (1 + e sqrt5)^(3L+1) (1 + e)^3L - 1)
+ * where `L = log2(n)` and `e = 2^-53`. The typical error is much smaller,
+ * of the order of `e |x| |y| sqrt(L)`.
+ */
+inline double fft_mul_error_bound(int n, double norm1, double norm2) {
+    double e = std::numeric_limits<double>::epsilon() / 2;
+    double L = log2(std::max(n, 2));
+    double g = expm1(6 * L * log1p(e) + (3 * L + 1) * log1p(e * sqrt(5.0)));
+    return norm1 * norm2 * g;
+}
+
+/**
+ * polynom<double> specialization
+ *
+ * Both real operands are packed into a single complex sequence,
+ * so that one forward and one inverse transform suffice.
+ * The error of the unpacked spectra scales with the norm of the packed
+ * sequence, so the second operand is first scaled by a power of two to
+ * about the norm of the first one; otherwise the product of operands of
+ * very different magnitudes would lose most of its precision.
+ */
+template<>
+struct polynom_mul<double> {
+    typedef complex<double> cplx;
+
+    static int next_pow2(int l) { int n = 1; while (n < l) n *= 2; return n; }
+
+    static void _mul_fft(double* pr, int lr, const double* p1, int l1, const double* p2, int l2) {
+        int n = next_pow2(l1 + l2 + 1);
+        auto root = complex_root_wrapper<double>(n);
+        root = powT(root, root.size / n);
+        auto iroot = powT(root, n - 1);
+        double s = (p1 == p2) ? 1.0 : balance(norm(p1, l1), norm(p2, l2));
+        // z = p1 + i p2 s
+        std::vector<cplx> z(n), tmp(n);
+        for (int i = 0; i <= l1; i++) z[i].a = p1[i];
+        for (int i = 0; i <= l2; i++) z[i].b = p2[i] * s;
+        fft_rec(tmp.data(), z.data(), n, root); std::swap(z, tmp);
+        for (int k = 0; k <= n / 2; k++) {
+            int l = (n - k) & (n - 1);
+            cplx x, y;
+            fft_unpack_real(z[k], z[l], &x, &y);
+            cplx w = x * y; // the product is real, so its spectrum is conjugate symmetric
+            z[k] = w, z[l] = w.conjugate();
+        }
+        fft_rec(tmp.data(), z.data(), n, iroot); std::swap(z, tmp);
+        for (int i = 0; i <= lr; i++) pr[i] = z[i].a / (n * s);
+    }
+
+    static double norm(const double* p, int l) { double s = 0; for (int i = 0; i <= l; i++) s += p[i] * p[i]; return sqrt(s); }
+
+    // a power of two `s`, such that `norm2 * s` is within a factor of two of `norm1`
+    static double balance(double norm1, double norm2) {
+        if (norm1 == 0 || norm2 == 0) return 1.0;
+        return ldexp(1.0, ilogb(norm1) - ilogb(norm2));
+    }
+
+    // an upper bound on the absolute error of each coefficient of `_mul_fft`; see `fft_mul_error_bound`
+    // the spectra are unpacked from that of `p1 + i p2 s`, so both norms are taken as its norm,
+    // and the few extra operations of the unpacking are accounted for by doubling the size
+    static double error_bound(const double* p1, int l1, const double* p2, int l2) {
+        double n1 = norm(p1, l1), n2 = norm(p2, l2), s = (p1 == p2) ? 1.0 : balance(n1, n2);
+        double h = hypot(n1, n2 * s);
+        return fft_mul_error_bound(next_pow2(l1 + l2 + 1) * 2, h, h) / s;
+    }
+
+    static double cost_karatsuba(int l1, int l2) { return 0.25 * l1 * pow(l2, 0.5849625); }
+    static double cost_fft(int l1, int l2) { int n = next_pow2(l1 + l2 + 1); return 0.5 * n * log2(n); }
+
+    static void impl(double* pr, int lr, const double* p1, int l1, const double* p2, int l2) {
+        if (l2 < 16) {
+            polynom<double>::_mul_long(pr, lr, p1, l1, p2, l2);
+        } else if (l2 < 64 || cost_karatsuba(l1, l2) < cost_fft(l1, l2)) {
+            polynom<double>::_mul_karatsuba(pr, lr, p1, l1, p2, l2);
+        } else {
+            _mul_fft(pr, lr, p1, l1, p2, l2);
+        }
+    }
+};
+
+/**
+ * polynom<complex<double>> specialization
+ *
+ * Both operands are transformed, multiplied pointwise and transformed back;
+ * a square takes one forward transform less.
+ */
+template<>
+struct polynom_mul<complex<double>> {
+    typedef complex<double> cplx;
+
+    static int next_pow2(int l) { int n = 1; while (n < l) n *= 2; return n; }
+
+    static void _mul_fft(cplx* pr, int lr, const cplx* p1, int l1, const cplx* p2, int l2) {
+        int n = next_pow2(l1 + l2 + 1);
+        auto root = complex_root_wrapper<double>(n);
+        root = powT(root, root.size / n);
+        auto iroot = powT(root, n - 1);
+        std::vector<cplx> a(n), b(n), tmp(n);
+        std::copy(p1, p1 + l1 + 1, tmp.begin());
+        fft_rec(a.data(), tmp.data(), n, root);
+        if (p1 == p2 && l1 == l2) {
+            for (int k = 0; k < n; k++) a[k] *= a[k];
+        } else {
+            std::fill(tmp.begin(), tmp.end(), cplx(0.0));
+            std::copy(p2, p2 + l2 + 1, tmp.begin());
+            fft_rec(b.data(), tmp.data(), n, root);
+            for (int k = 0; k < n; k++) a[k] *= b[k];
+        }
+        fft_rec(tmp.data(), a.data(), n, iroot);
+        for (int i = 0; i <= lr; i++) pr[i] = tmp[i] / double(n);
+    }
+
+    static double norm(const cplx* p, int l) { double s = 0; for (int i = 0; i <= l; i++) s += p[i].a * p[i].a + p[i].b * p[i].b; return sqrt(s); }
+
+    // an upper bound on the absolute error of each coefficient of `_mul_fft`; see `fft_mul_error_bound`
+    static double error_bound(const cplx* p1, int l1, const cplx* p2, int l2) {
+        return fft_mul_error_bound(next_pow2(l1 + l2 + 1), norm(p1, l1), norm(p2, l2));
+    }
+
+    static double cost_karatsuba(int l1, int l2) { return 1.0 * l1 * pow(l2, 0.5849625); }
+    static double cost_fft(int l1, int l2) { int n = next_pow2(l1 + l2 + 1); return 1.0 * n * log2(n); }
+
+    static void impl(cplx* pr, int lr, const cplx* p1, int l1, const cplx* p2, int l2) {
+        if (l2 < 16) {
+            polynom<cplx>::_mul_long(pr, lr, p1, l1, p2, l2);
+        } else if (l2 < 64 || cost_karatsuba(l1, l2) < cost_fft(l1, l2)) {
+            polynom<cplx>::_mul_karatsuba(pr, lr, p1, l1, p2, l2);
+        } else {
+            _mul_fft(pr, lr, p1, l1, p2, l2);
+        }
+    }
+};
+
+} // math
+} // altruct
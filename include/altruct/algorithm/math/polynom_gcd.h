@@ -0,0 +1,178 @@
+#pragma once
+
+#include "altruct/algorithm/math/base.h"
+#include "altruct/structure/math/polynom.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace altruct {
+namespace math {
+
+/**
+ * 2x2 matrix of polynomials that maps a pair of consecutive remainders
+ * of the Euclidean algorithm to a later such pair: `(c, d) = M (a, b)`.
+ */
+template<typename T>
+struct polynom_gcd_matrix {
+    polynom<T> m[2][2];
+
+    // the identity matrix
+    explicit polynom_gcd_matrix(const T& e0) {
+        m[0][0] = m[1][1] = polynom<T>(identityOf(e0));
+        m[0][1] = m[1][0] = polynom<T>(e0);
+    }
+
+    // M := [[0, 1], [1, -q]] M; a single step of the Euclidean algorithm
+    void step(const polynom<T>& q) {
+        for (int j = 0; j < 2; j++) {
+            polynom<T> t = m[0][j] - q * m[1][j];
+            m[0][j].swap(m[1][j]);
+            m[1][j].swap(t);
+        }
+    }
+
+    // (a, b) := M (a, b)
+    void apply(polynom<T>& a, polynom<T>& b) const {
+        polynom<T> c = m[0][0] * a + m[0][1] * b;
+        polynom<T> d = m[1][0] * a + m[1][1] * b;
+        a.swap(c);
+        b.swap(d);
+    }
+
+    polynom_gcd_matrix operator * (const polynom_gcd_matrix& rhs) const {
+        polynom_gcd_matrix r(m[0][0].ZERO_COEFF);
+        for (int i = 0; i < 2; i++) {
+            for (int j = 0; j < 2; j++) {
+                r.m[i][j] = m[i][0] * rhs.m[0][j] + m[i][1] * rhs.m[1][j];
+            }
+        }
+        return r;
+    }
+};
+
+// the degree of `p`, or -1 if `p` is zero
+template<typename T>
+int polynom_gcd_deg(const polynom<T>& p) {
+    int l = p.deg();
+    return (l == 0 && p.at(0) == p.ZERO_COEFF) ? -1 : l;
+}
+
+// p / x^k
+template<typename T>
+polynom<T> polynom_gcd_shift(const polynom<T>& p, int k) {
+    if (p.size() <= k) return polynom<T>(p.ZERO_COEFF);
+    polynom<T> r(p.c.begin() + k, p.c.end());
+    return r.normalize();
+}
+
+// (a, b) := (b, a % b), and returns `a / b`; `deg a >= deg b >= 0` must hold
+template<typename T>
+polynom<T> polynom_gcd_step(polynom<T>& a, polynom<T>& b) {
+    int la = a.deg(), lb = b.deg();
+    polynom<T> t(a.ZERO_COEFF);
+    polynom<T>::quot_rem(t, a, b);
+    polynom<T> q(t.c.begin() + lb, t.c.begin() + la + 1);
+    if (lb == 0) t = polynom<T>(a.ZERO_COEFF);
+    t.resize(std::max(lb, 1));
+    t.normalize();
+    a.swap(b);
+    b.swap(t);
+    return q;
+}
+
+// the degree below which `half_gcd` computes the remainder sequence directly
+inline int& half_gcd_threshold() { static int threshold = 64; return threshold; }
+
+/**
+ * Half-GCD
+ *
+ * Returns the matrix `M`, such that `(c, d) = M (a, b)` are the consecutive
+ * remainders of the Euclidean algorithm with `deg c >= ceil(deg a / 2) > deg d`.
+ * `deg a > deg b` must hold, and the coefficients must be a field.
+ *
+ * The quotients of the first half of the remainder sequence only depend on the
+ * upper halves of `a` and `b`, so `M` is found by two recursive calls on
+ * polynomials of half the degree; O(M(n) log n), where M(n) is the multiplication
+ * cost. Below `half_gcd_threshold` the remainder sequence is computed directly.
+ */
+template<typename T>
+polynom_gcd_matrix<T> half_gcd(const polynom<T>& a, const polynom<T>& b) {
+    int n = polynom_gcd_deg(a), m = (n + 1) / 2;
+    polynom_gcd_matrix<T> r(a.ZERO_COEFF);
+    if (polynom_gcd_deg(b) < m) return r;
+    polynom<T> c = a, d = b;
+    if (n < half_gcd_threshold()) {
+        while (polynom_gcd_deg(d) >= m) {
+            r.step(polynom_gcd_step(c, d));
+        }
+        return r;
+    }
+    r = half_gcd(polynom_gcd_shift(a, m), polynom_gcd_shift(b, m));
+    r.apply(c, d);
+    if (polynom_gcd_deg(d) < m) return r;
+    r.step(polynom_gcd_step(c, d));
+    int k = m * 2 - polynom_gcd_deg(c);
+    return half_gcd(polynom_gcd_shift(c, k), polynom_gcd_shift(d, k)) * r;
+}
+
+/**
+ * Greatest Common Divisor of polynomials, by the Half-GCD; O(M(n) log n)
+ *
+ * The coefficients must be a field. The result is monic, unless both `a` and `b` are zero.
+ */
+template<typename T>
+polynom<T> polynom_gcd(const polynom<T>& a, const polynom<T>& b) {
+    polynom<T> c = a, d = b;
+    c.normalize(); d.normalize();
+    if (polynom_gcd_deg(c) < polynom_gcd_deg(d)) c.swap(d);
+    while (polynom_gcd_deg(d) >= 0) {
+        if (polynom_gcd_deg(c) > polynom_gcd_deg(d)) {
+            half_gcd(c, d).apply(c, d);
+            if (polynom_gcd_deg(d) < 0) break;
+        }
+        polynom_gcd_step(c, d);
+    }
+    if (polynom_gcd_deg(c) < 0) return c;
+    return c / c.leading_coeff();
+}
+
+/**
+ * Extended Greatest Common Divisor of polynomials, by the Half-GCD; O(M(n) log n)
+ *
+ * Calculates `x`, `y` and `g` so that: `a * x + b * y = g`.
+ * The coefficients must be a field. The result is monic, unless both `a` and `b` are zero.
+ *
+ * @param a - the first operand
+ * @param b - the second operand
+ * @param x - the output argument `x`
+ * @param y - the output argument `y`
+ * @return g - the greatest common divisor of `a` and `b`
+ */
+template<typename T>
+polynom<T> polynom_gcd_ex(const polynom<T>& a, const polynom<T>& b, polynom<T> *x = 0, polynom<T> *y = 0) {
+    polynom_gcd_matrix<T> r(a.ZERO_COEFF);
+    polynom<T> c = a, d = b;
+    c.normalize(); d.normalize();
+    if (polynom_gcd_deg(c) < polynom_gcd_deg(d)) {
+        c.swap(d);
+        std::swap(r.m[0], r.m[1]);
+    }
+    while (polynom_gcd_deg(d) >= 0) {
+        if (polynom_gcd_deg(c) > polynom_gcd_deg(d)) {
+            auto s = half_gcd(c, d);
+            s.apply(c, d);
+            r = s * r;
+            if (polynom_gcd_deg(d) < 0) break;
+        }
+        r.step(polynom_gcd_step(c, d));
+    }
+    T lc = identityOf(c.ZERO_COEFF);
+    if (polynom_gcd_deg(c) >= 0) lc = c.leading_coeff();
+    if (x) *x = r.m[0][0] / lc;
+    if (y) *y = r.m[0][1] / lc;
+    return c / lc;
+}
+
+} // math
+} // altruct
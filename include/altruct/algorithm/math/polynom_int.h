@@ -0,0 +1,118 @@
+#pragma once
+
+#include "altruct/algorithm/math/ntt.h"
+#include "altruct/structure/math/modulo.h"
+#include "altruct/structure/math/polynom.h"
+
+#include <cmath>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+namespace altruct {
+namespace math {
+
+/**
+ * polynom<int64_t> multiplication
+ *
+ * Shared by the signed and unsigned 64-bit specializations below.
+ * Large products are done exactly by three NTTs over fixed primes, recombined
+ * by the Chinese Remainder Theorem, provided that the product coefficients are
+ * guaranteed to fit in `I`; i.e. `max|p1| * max|p2| * (min(l1, l2) + 1) <= max(I)`,
+ * which is checked upfront in O(l1 + l2). Otherwise, the generic paths are used,
+ * which wrap around on overflow as usual.
+ */
+template<typename I>
+struct polynom_mul_int64 {
+    typedef typename std::make_unsigned<I>::type U;
+    typedef modulo<int, 998244353, modulo_storage::CONSTANT> mod0;
+    typedef modulo<int, 167772161, modulo_storage::CONSTANT> mod1;
+    typedef modulo<int, 469762049, modulo_storage::CONSTANT> mod2;
+
+    static int next_pow2(int l) { int n = 1; while (n < l) n *= 2; return n; }
+    static U magnitude(I x) { return (x < 0) ? U(0) - U(x) : U(x); }
+    static U max_magnitude(const I* p, int l) { U m = 0; for (int i = 0; i <= l; i++) m = std::max(m, magnitude(p[i])); return m; }
+
+    // whether `max|p1| * max|p2| * (min(l1, l2) + 1) <= max(I)`
+    static bool is_bounded(const I* p1, int l1, const I* p2, int l2) {
+        U a = max_magnitude(p1, l1), b = (p1 == p2 && l1 == l2) ? a : max_magnitude(p2, l2);
+        U lim = U(std::numeric_limits<I>::max()), k = U(std::min(l1, l2) + 1);
+        if (a == 0 || b == 0) return true;
+        return (a <= lim / b) && (a * b <= lim / k);
+    }
+
+    // NTT image modulo the NTT-friendly prime `P` of size `n`
+    template<typename P>
+    static std::vector<P> _ntt_image(int n, const I* p, int l) {
+        std::vector<P> a(n, P(0));
+        for (int i = 0; i <= l; i++) {
+            int64_t r = int64_t(magnitude(p[i]) % U(P::M()));
+            a[i] = (p[i] < 0) ? -P(int(r)) : P(int(r));
+        }
+        ntt_dif(a.data(), n, ntt_roots<P>::get(P(1), n));
+        return a;
+    }
+
+    // convolution modulo the NTT-friendly prime `P`
+    template<typename P>
+    static std::vector<P> _conv_ntt_prime(int n, const I* p1, int l1, const I* p2, int l2) {
+        auto a = _ntt_image<P>(n, p1, l1);
+        if (p1 == p2 && l1 == l2) {
+            for (int i = 0; i < n; i++) a[i] *= a[i];
+        } else {
+            auto b = _ntt_image<P>(n, p2, l2);
+            for (int i = 0; i < n; i++) a[i] *= b[i];
+        }
+        ntt_dit(a.data(), n, ntt_roots<P>::get(P(1), n));
+        P in = P(1) / P(n);
+        for (int i = 0; i < n; i++) a[i] *= in;
+        return a;
+    }
+
+    // three NTTs over fixed primes, recombined by the Chinese Remainder Theorem; exact
+    // works for `is_bounded(p1, l1, p2, l2)` and `l1 + l2 < 2^23`, as `2 * 2^63 < p0 * p1 * p2`
+    static void _mul_ntt3(I* pr, int lr, const I* p1, int l1, const I* p2, int l2) {
+        int n = next_pow2(l1 + l2 + 1);
+        auto c0 = _conv_ntt_prime<mod0>(n, p1, l1, p2, l2);
+        auto c1 = _conv_ntt_prime<mod1>(n, p1, l1, p2, l2);
+        auto c2 = _conv_ntt_prime<mod2>(n, p1, l1, p2, l2);
+        // mixed radix form `c = x0 + x1 * p0 + x2 * p0 * p1`, evaluated modulo 2^64;
+        // a negative `c` is represented by `c + p0 * p1 * p2`, which has `x2 >= p2 / 2`
+        const mod1 i0_1 = mod1(1) / mod1(mod0::M());
+        const mod2 i01_2 = mod2(1) / (mod2(mod0::M()) * mod2(mod1::M()));
+        const uint64_t p0 = mod0::M(), p01 = p0 * mod1::M(), p012 = p01 * mod2::M();
+        for (int i = 0; i <= lr; i++) {
+            int x0 = c0[i].v;
+            int x1 = ((c1[i] - mod1(x0)) * i0_1).v;
+            int x2 = ((c2[i] - mod2(x0) - mod2(x1) * mod2(mod0::M())) * i01_2).v;
+            uint64_t c = x0 + x1 * p0 + x2 * p01;
+            if (x2 >= mod2::M() / 2) c -= p012;
+            pr[i] = I(c);
+        }
+    }
+
+    static double cost_karatsuba(int l1, int l2) { return 0.25 * l1 * pow(l2, 0.5849625); }
+    static double cost_ntt3(int l1, int l2) { int n = next_pow2(l1 + l2 + 1); return 0.75 * n * log2(n); }
+    static bool is_ntt3_friendly(int l1, int l2) { return l1 + l2 + 1 <= (1 << 23); }
+
+    static void impl(I* pr, int lr, const I* p1, int l1, const I* p2, int l2) {
+        if (l2 < 15 || int64_t(l1) * l2 < 300) {
+            polynom<I>::_mul_long(pr, lr, p1, l1, p2, l2);
+        } else if (l2 < 256 || !is_ntt3_friendly(l1, l2) || cost_karatsuba(l1, l2) < cost_ntt3(l1, l2) || !is_bounded(p1, l1, p2, l2)) {
+            polynom<I>::_mul_karatsuba(pr, lr, p1, l1, p2, l2);
+        } else {
+            _mul_ntt3(pr, lr, p1, l1, p2, l2);
+        }
+    }
+};
+
+/**
+ * polynom<int64_t> and polynom<uint64_t> specializations
+ */
+template<> struct polynom_mul<long long> : polynom_mul_int64<long long> {};
+template<> struct polynom_mul<unsigned long long> : polynom_mul_int64<unsigned long long> {};
+template<> struct polynom_mul<long> : polynom_mul_int64<long> {};
+template<> struct polynom_mul<unsigned long> : polynom_mul_int64<unsigned long> {};
+
+} // math
+} // altruct
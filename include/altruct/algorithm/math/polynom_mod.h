@@ -2,6 +2,7 @@
 
 #include "modulos.h"
 #include "altruct/algorithm/math/fft.h"
+#include "altruct/algorithm/math/ntt.h"
 #include "altruct/structure/math/root_wrapper.h"
 #include "altruct/structure/math/complex.h"
 #include "altruct/structure/math/modulo.h"
@@ -11,84 +12,195 @@ namespace altruct {
 namespace math {
 
 /**
- * polynom<modulo<int>> specialization
+ * polynom<modulo<int>> multiplication
+ *
+ * Shared by the `CONSTANT` and `MONTGOMERY` specializations below.
+ * Dispatches through `polynom_mul<mod>` so that a specialization
+ * can replace any of the individual implementations.
  */
-template<int ID>
-struct polynom_mul<modulo<int, ID, modulo_storage::CONSTANT>> {
-    typedef modulo<int, ID, modulo_storage::CONSTANT> mod;
+template<typename mod>
+struct polynom_mul_modulo_int {
     typedef complex<double> cplx;
 
     static int next_pow2(int l) { int n = 1; while (n < l) n *= 2; return n; }
-    static int64_t rnd(const cplx& z, int n) { return llround(z.a / n) % mod::M(); }
+    static int64_t rnd(double x, int n) { return llround(x / n) % mod::M(); }
+
+    // `x + i y` and `conj(x) + i conj(y)`, i.e. the spectra at `k` and `-k`
+    // of the complex sequence packing the real sequences with spectra `x` and `y`
+    static void pack(const cplx& x, const cplx& y, cplx* zk, cplx* zl) {
+        *zk = cplx(x.a - y.b, x.b + y.a);
+        *zl = cplx(x.a + y.b, y.a - x.b);
+    }
 
     // splits coefficients into three 10-bit blocks each to avoid overflow
     // works for `mod::M < 2^30` and `la, lb <= 2^30`;
+    // real blocks are packed in pairs, so that three forward and three inverse transforms suffice
     static void _mul_fft_big(mod* pr, int lr, const mod* pa, int la, const mod* pb, int lb) {
         int n = next_pow2(la + lb + 1);
         auto root = complex_root_wrapper<double>(n);
         root = powT(root, root.size / n);
         auto iroot = powT(root, n - 1);
-        std::vector<cplx> a2(n), a1(n), a0(n), b2(n), b1(n), b0(n), tmp(n);
-        for (int i = 0; i <= la; i++) a2[i] = pa[i].v >> 20, a1[i] = (pa[i].v >> 10) & 0x3FF, a0[i] = pa[i].v & 0x3FF;
-        for (int i = 0; i <= lb; i++) b2[i] = pb[i].v >> 20, b1[i] = (pb[i].v >> 10) & 0x3FF, b0[i] = pb[i].v & 0x3FF;
-        fft_rec(tmp.data(), a2.data(), n, root); std::swap(a2, tmp);
-        fft_rec(tmp.data(), a1.data(), n, root); std::swap(a1, tmp);
-        fft_rec(tmp.data(), a0.data(), n, root); std::swap(a0, tmp);
-        fft_rec(tmp.data(), b2.data(), n, root); std::swap(b2, tmp);
-        fft_rec(tmp.data(), b1.data(), n, root); std::swap(b1, tmp);
-        fft_rec(tmp.data(), b0.data(), n, root); std::swap(b0, tmp);
-        for (int i = 0; i < n; i++) {
-            auto w22 = a2[i] * b2[i];
-            auto w11 = a1[i] * b1[i];
-            auto w00 = a0[i] * b0[i];
-            auto w21 = (a2[i] + a1[i]) * (b2[i] + b1[i]);
-            auto w10 = (a1[i] + a0[i]) * (b1[i] + b0[i]);
-            auto w210 = (a2[i] + a1[i] + a0[i]) * (b2[i] + b1[i] + b0[i]);
-            a2[i] = w22, a1[i] = w11, a0[i] = w00, b2[i] = w21, b1[i] = w10, b0[i] = w210;
+        // z0 = a2 + i a1, z1 = a0 + i b0, z2 = b2 + i b1
+        std::vector<cplx> z0(n), z1(n), z2(n), tmp(n);
+        for (int i = 0; i <= la; i++) z0[i] = cplx(pa[i].v >> 20, (pa[i].v >> 10) & 0x3FF), z1[i].a = pa[i].v & 0x3FF;
+        for (int i = 0; i <= lb; i++) z2[i] = cplx(pb[i].v >> 20, (pb[i].v >> 10) & 0x3FF), z1[i].b = pb[i].v & 0x3FF;
+        fft_rec(tmp.data(), z0.data(), n, root); std::swap(z0, tmp);
+        fft_rec(tmp.data(), z1.data(), n, root); std::swap(z1, tmp);
+        fft_rec(tmp.data(), z2.data(), n, root); std::swap(z2, tmp);
+        for (int k = 0; k <= n / 2; k++) {
+            int l = (n - k) & (n - 1);
+            cplx a2, a1, a0, b2, b1, b0;
+            fft_unpack_real(z0[k], z0[l], &a2, &a1);
+            fft_unpack_real(z1[k], z1[l], &a0, &b0);
+            fft_unpack_real(z2[k], z2[l], &b2, &b1);
+            auto w22 = a2 * b2;
+            auto w11 = a1 * b1;
+            auto w00 = a0 * b0;
+            auto w21 = (a2 + a1) * (b2 + b1);
+            auto w10 = (a1 + a0) * (b1 + b0);
+            auto w210 = (a2 + a1 + a0) * (b2 + b1 + b0);
+            // z0 = w22 + i w11, z1 = w00 + i w21, z2 = w10 + i w210
+            pack(w22, w11, &z0[k], &z0[l]);
+            pack(w00, w21, &z1[k], &z1[l]);
+            pack(w10, w210, &z2[k], &z2[l]);
         }
-        fft_rec(tmp.data(), a2.data(), n, iroot); std::swap(a2, tmp);
-        fft_rec(tmp.data(), a1.data(), n, iroot); std::swap(a1, tmp);
-        fft_rec(tmp.data(), a0.data(), n, iroot); std::swap(a0, tmp);
-        fft_rec(tmp.data(), b2.data(), n, iroot); std::swap(b2, tmp);
-        fft_rec(tmp.data(), b1.data(), n, iroot); std::swap(b1, tmp);
-        fft_rec(tmp.data(), b0.data(), n, iroot); std::swap(b0, tmp);
+        fft_rec(tmp.data(), z0.data(), n, iroot); std::swap(z0, tmp);
+        fft_rec(tmp.data(), z1.data(), n, iroot); std::swap(z1, tmp);
+        fft_rec(tmp.data(), z2.data(), n, iroot); std::swap(z2, tmp);
         for (int i = 0; i <= lr; i++) {
-            auto z11 = ((rnd(a2[i], n) << 20) + (rnd(b2[i] - a2[i] - a1[i], n) << 10) + rnd(a1[i], n));
-            auto z01 = ((rnd(a2[i], n) << 20) + (rnd(b0[i] - a2[i] - b1[i], n) << 10) + rnd(b1[i], n));
-            auto z00 = rnd(a0[i], n);
-            pr[i] = ((z11 % mod::M() << 20) + ((z01 - z11 - z00) % mod::M() << 10) + z00) % mod::M();
+            auto r22 = rnd(z0[i].a, n), r11 = rnd(z0[i].b, n), r00 = rnd(z1[i].a, n);
+            auto z11 = ((r22 << 20) + (rnd(z1[i].b - z0[i].a - z0[i].b, n) << 10) + r11);
+            auto z01 = ((r22 << 20) + (rnd(z2[i].b - z0[i].a - z2[i].a, n) << 10) + rnd(z2[i].a, n));
+            pr[i] = ((z11 % mod::M() << 20) + ((z01 - z11 - r00) % mod::M() << 10) + r00) % mod::M();
         }
     }
 
     // splits coefficients into two 16-bit blocks each to avoid overflow
     // works for `mod::M < 2^30` and `l1, l2 <= 2^18`; e.g.: `M = 10^9+7, l = 250.000`
+    // real blocks are packed in pairs, so that two forward and two inverse transforms suffice
     static void _mul_fft(mod* pr, int lr, const mod* p1, int l1, const mod* p2, int l2) {
         int n = next_pow2(l1 + l2 + 1);
         auto root = complex_root_wrapper<double>(n);
         root = powT(root, root.size / n);
         auto iroot = powT(root, n - 1);
-        std::vector<cplx> hi1(n), lo1(n), hi2(n), lo2(n), tmp(n);
-        for (int i = 0; i <= l1; i++) hi1[i] = p1[i].v >> 16, lo1[i] = p1[i].v & 0xFFFF;
-        for (int i = 0; i <= l2; i++) hi2[i] = p2[i].v >> 16, lo2[i] = p2[i].v & 0xFFFF;
-        fft_rec(tmp.data(), hi1.data(), n, root); std::swap(hi1, tmp);
-        fft_rec(tmp.data(), lo1.data(), n, root); std::swap(lo1, tmp);
-        fft_rec(tmp.data(), hi2.data(), n, root); std::swap(hi2, tmp);
-        fft_rec(tmp.data(), lo2.data(), n, root); std::swap(lo2, tmp);
-        for (int i = 0; i < n; i++) {
-            auto h = hi1[i] * hi2[i];
-            auto l = lo1[i] * lo2[i];
-            auto m = lo1[i] * hi2[i] + lo2[i] * hi1[i];
-            lo1[i] = l, hi1[i] = m, hi2[i] = h;
+        // z1 = hi1 + i lo1, z2 = hi2 + i lo2
+        std::vector<cplx> z1(n), z2(n), tmp(n);
+        for (int i = 0; i <= l1; i++) z1[i] = cplx(p1[i].v >> 16, p1[i].v & 0xFFFF);
+        fft_rec(tmp.data(), z1.data(), n, root); std::swap(z1, tmp);
+        if (p1 == p2 && l1 == l2) {
+            z2 = z1;
+        } else {
+            for (int i = 0; i <= l2; i++) z2[i] = cplx(p2[i].v >> 16, p2[i].v & 0xFFFF);
+            fft_rec(tmp.data(), z2.data(), n, root); std::swap(z2, tmp);
+        }
+        for (int k = 0; k <= n / 2; k++) {
+            int j = (n - k) & (n - 1);
+            cplx hi1, lo1, hi2, lo2;
+            fft_unpack_real(z1[k], z1[j], &hi1, &lo1);
+            fft_unpack_real(z2[k], z2[j], &hi2, &lo2);
+            auto h = hi1 * hi2;
+            auto l = lo1 * lo2;
+            auto m = lo1 * hi2 + lo2 * hi1;
+            // z1 = h + i l, z2 = m
+            pack(h, l, &z1[k], &z1[j]);
+            z2[k] = m, z2[j] = m.conjugate();
         }
-        fft_rec(tmp.data(), hi1.data(), n, iroot); std::swap(hi1, tmp);
-        fft_rec(tmp.data(), lo1.data(), n, iroot); std::swap(lo1, tmp);
-        fft_rec(tmp.data(), hi2.data(), n, iroot); std::swap(hi2, tmp);
+        fft_rec(tmp.data(), z1.data(), n, iroot); std::swap(z1, tmp);
+        fft_rec(tmp.data(), z2.data(), n, iroot); std::swap(z2, tmp);
         for (int i = 0; i <= lr; i++) {
-            auto h = rnd(hi2[i], n), m = rnd(hi1[i], n), l = rnd(lo1[i], n);
+            auto h = rnd(z1[i].a, n), m = rnd(z2[i].a, n), l = rnd(z1[i].b, n);
             pr[i] = ((l << 0) + (m << 16) + (h << 32)) % mod::M();
         }
     }
 
+    // number theoretic transform over the modulus itself; exact
+    // works for NTT-friendly prime `mod::M` and `l1 + l2 < ntt_roots<mod>::max_size()`
+    // e.g.: `M = 998244353` up to `2^23`, `M = 469762049` up to `2^26`
+    // the buffers are taken from `polynom_scratch<mod>`
+    static void _mul_ntt(mod* pr, int lr, const mod* p1, int l1, const mod* p2, int l2) {
+        int n = next_pow2(l1 + l2 + 1);
+        const auto& tbl = ntt_roots<mod>::get(mod(1), n);
+        typename polynom_scratch<mod>::frame ws(n * 2, mod(0));
+        mod* a = ws.take(n, mod(0));
+        std::copy(p1, p1 + l1 + 1, a);
+        std::fill(a + l1 + 1, a + n, mod(0));
+        ntt_dif(a, n, tbl);
+        if (p1 == p2 && l1 == l2) {
+            for (int i = 0; i < n; i++) a[i] *= a[i];
+        } else {
+            mod* b = ws.take(n, mod(0));
+            std::copy(p2, p2 + l2 + 1, b);
+            std::fill(b + l2 + 1, b + n, mod(0));
+            ntt_dif(b, n, tbl);
+            for (int i = 0; i < n; i++) a[i] *= b[i];
+        }
+        ntt_dit(a, n, tbl);
+        mod in = mod(1) / mod(n);
+        for (int i = 0; i <= lr; i++) pr[i] = a[i] * in;
+    }
+
+    // NTT image modulo the NTT-friendly prime `P` of size `n`, coefficients are taken by value
+    template<typename P>
+    static std::vector<P> _ntt_image(int n, const mod* p, int l) {
+        const auto& tbl = ntt_roots<P>::get(P(1), n);
+        std::vector<P> a(n);
+        for (int i = 0; i <= l; i++) a[i] = P(int(p[i].v));
+        ntt_dif(a.data(), n, tbl);
+        return a;
+    }
+
+    // a = a * b pointwise, transformed back; not divided by the size
+    // it is allowed for `a` and `b` to be the same instance
+    template<typename P>
+    static void _ntt_product(std::vector<P>& a, const std::vector<P>& b) {
+        int n = (int)a.size();
+        for (int i = 0; i < n; i++) a[i] *= b[i];
+        ntt_dit(a.data(), n, ntt_roots<P>::get(P(1), n));
+    }
+
+    // convolution modulo the NTT-friendly prime `P`, coefficients are taken by value
+    template<typename P>
+    static std::vector<P> _conv_ntt_prime(int n, const mod* p1, int l1, const mod* p2, int l2) {
+        auto a = _ntt_image<P>(n, p1, l1);
+        if (p1 == p2 && l1 == l2) {
+            _ntt_product(a, a);
+        } else {
+            _ntt_product(a, _ntt_image<P>(n, p2, l2));
+        }
+        P in = P(1) / P(n);
+        for (int i = 0; i < n; i++) a[i] *= in;
+        return a;
+    }
+
+    typedef modulo<int, 998244353, modulo_storage::CONSTANT> mod0;
+    typedef modulo<int, 167772161, modulo_storage::CONSTANT> mod1;
+    typedef modulo<int, 469762049, modulo_storage::CONSTANT> mod2;
+
+    // recombines the residues modulo the three fixed primes by the Chinese Remainder Theorem
+    // pr[i - lo] = c[i], for `lo <= i <= hr`
+    static void _crt_ntt3(mod* pr, int lo, int hr, const std::vector<mod0>& c0, const std::vector<mod1>& c1, const std::vector<mod2>& c2) {
+        // mixed radix form `c = x0 + x1 * p0 + x2 * p0 * p1`, same as `garner` computes
+        const mod1 i0_1 = mod1(1) / mod1(mod0::M());
+        const mod2 i01_2 = mod2(1) / (mod2(mod0::M()) * mod2(mod1::M()));
+        const int64_t M = mod::M(), p0 = mod0::M() % M, p01 = int64_t(mod0::M()) * mod1::M() % M;
+        for (int i = lo; i <= hr; i++) {
+            int x0 = c0[i].v;
+            int x1 = ((c1[i] - mod1(x0)) * i0_1).v;
+            int x2 = ((c2[i] - mod2(x0) - mod2(x1) * mod2(mod0::M())) * i01_2).v;
+            pr[i - lo] = mod(int((x0 + x1 * p0 + x2 % M * p01) % M));
+        }
+    }
+
+    // three NTTs over fixed primes, recombined by the Chinese Remainder Theorem; exact
+    // works for `mod::M < 2^31` and `l1 + l2 < 2^23`, as `2^23 * M^2 < p0 * p1 * p2`
+    static void _mul_ntt3(mod* pr, int lr, const mod* p1, int l1, const mod* p2, int l2) {
+        int n = next_pow2(l1 + l2 + 1);
+        auto c0 = _conv_ntt_prime<mod0>(n, p1, l1, p2, l2);
+        auto c1 = _conv_ntt_prime<mod1>(n, p1, l1, p2, l2);
+        auto c2 = _conv_ntt_prime<mod2>(n, p1, l1, p2, l2);
+        _crt_ntt3(pr, 0, lr, c0, c1, c2);
+    }
+
     static void _mul_long(mod* pr, int lr, const mod* p1, int l1, const mod* p2, int l2) {
         for (int i = lr; i >= 0; i--) {
             int64_t r = 0;
@@ -102,13 +214,26 @@ struct polynom_mul<modulo<int, ID, modulo_storage::CONSTANT>> {
     }
 
     static double cost_karatsuba(int l1, int l2) { return 0.25 * l1 * pow(l2, 0.5849625); }
-    static double cost_fft(int l1, int l2) { int n = next_pow2(l1 + l2 + 1); return 0.5 * n * log2(n); }
+    // the complex working set no longer fits in the cache beyond `2^16`
+    static double cost_fft(int l1, int l2) { int n = next_pow2(l1 + l2 + 1); return ((n > (1 << 16)) ? 0.5 : 0.25) * n * log2(n); }
+    static double cost_ntt(int l1, int l2) { int n = next_pow2(l1 + l2 + 1); return 0.125 * n * log2(n); }
+    static double cost_ntt3(int l1, int l2) { int n = next_pow2(l1 + l2 + 1); return 0.3 * n * log2(n); }
+    static bool is_ntt_friendly(int l1, int l2) { return next_pow2(l1 + l2 + 1) <= ntt_roots<mod>::get(mod(1)).max_size(); }
+    static bool is_ntt3_friendly(int l1, int l2) { return l1 + l2 + 1 <= (1 << 23); }
 
     static void impl(mod* pr, int lr, const mod* p1, int l1, const mod* p2, int l2) {
         if (l2 < 16) {
-            _mul_long(pr, lr, p1, l1, p2, l2);
+            polynom_mul<mod>::_mul_long(pr, lr, p1, l1, p2, l2);
+        } else if (is_ntt_friendly(l1, l2)) {
+            if (l2 < 64 || cost_karatsuba(l1, l2) < cost_ntt(l1, l2)) {
+                polynom<mod>::_mul_karatsuba(pr, lr, p1, l1, p2, l2);
+            } else {
+                _mul_ntt(pr, lr, p1, l1, p2, l2);
+            }
         } else if (l2 < 300 || cost_karatsuba(l1, l2) < cost_fft(l1, l2)) {
             polynom<mod>::_mul_karatsuba(pr, lr, p1, l1, p2, l2);
+        } else if (is_ntt3_friendly(l1, l2) && (mod::M() >= (1 << 30) || cost_ntt3(l1, l2) < cost_fft(l1, l2))) {
+            _mul_ntt3(pr, lr, p1, l1, p2, l2);
         } else if (l1 <= 250000) {
             _mul_fft(pr, lr, p1, l1, p2, l2);
         } else {
@@ -117,5 +242,178 @@ struct polynom_mul<modulo<int, ID, modulo_storage::CONSTANT>> {
     }
 };
 
+/**
+ * polynom<modulo<int>> operand kept in the transform domain
+ *
+ * Shared by the `CONSTANT` and `MONTGOMERY` specializations below.
+ * The image is computed once, of the size needed for the expected degree
+ * of the other factor, and already divided by that size. Products that need
+ * a different size, or are too small to be done by an NTT, are done as usual.
+ */
+template<typename mod>
+class polynom_operand_modulo_int {
+    typedef polynom_mul<mod> pm;
+    typedef typename pm::mod0 mod0;
+    typedef typename pm::mod1 mod1;
+    typedef typename pm::mod2 mod2;
+
+    // scales the image by `1/n` so that products need not be
+    template<typename P>
+    static std::vector<P> scaled(std::vector<P>&& a) {
+        P in = P(1) / P((int)a.size());
+        for (auto& x : a) x *= in;
+        return std::move(a);
+    }
+
+public:
+    polynom<mod> p;
+    int l2;                 // the degree of `p`
+    int n;                  // the transform size; 0 if not transformed
+    std::vector<mod> f;     // the image over `mod::M` itself, if NTT-friendly
+    std::vector<mod0> f0;   // the images over the three fixed primes otherwise
+    std::vector<mod1> f1;
+    std::vector<mod2> f2;
+
+    explicit polynom_operand_modulo_int(const polynom<mod> &p, int l1 = -1) : p(p), l2(p.deg()), n(0) {
+        if (l1 < 0) l1 = l2;
+        int la = std::max(l1, l2), lb = std::min(l1, l2);
+        if (lb < 64 || this->p.size() == 0) return;
+        // one forward transform of the three is saved per product
+        if (pm::is_ntt_friendly(la, lb)) {
+            if (pm::cost_karatsuba(la, lb) < pm::cost_ntt(la, lb) * 2 / 3) return;
+            n = pm::next_pow2(l1 + l2 + 1);
+            f.assign(n, mod(0));
+            std::copy(this->p.c.begin(), this->p.c.begin() + l2 + 1, f.begin());
+            ntt_dif(f.data(), n, ntt_roots<mod>::get(mod(1), n));
+            f = scaled(std::move(f));
+        } else if (pm::is_ntt3_friendly(la, lb)) {
+            double cost = pm::cost_karatsuba(la, lb);
+            if (mod::M() < (1 << 30)) cost = std::min(cost, pm::cost_fft(la, lb));
+            if (cost < pm::cost_ntt3(la, lb) * 2 / 3) return;
+            n = pm::next_pow2(l1 + l2 + 1);
+            f0 = scaled(pm::template _ntt_image<mod0>(n, this->p.c.data(), l2));
+            f1 = scaled(pm::template _ntt_image<mod1>(n, this->p.c.data(), l2));
+            f2 = scaled(pm::template _ntt_image<mod2>(n, this->p.c.data(), l2));
+        }
+    }
+
+    // r[i - lo] = (p1 * p)[i], for `lo <= i <= hr < n`, by the cyclic convolution of size `n`
+    void conv(std::vector<mod> &r, const mod* p1, int l1, int lo, int hr) const {
+        if (!f.empty()) {
+            std::vector<mod> a(n);
+            std::copy(p1, p1 + l1 + 1, a.begin());
+            ntt_dif(a.data(), n, ntt_roots<mod>::get(mod(1), n));
+            pm::_ntt_product(a, f);
+            std::copy(a.begin() + lo, a.begin() + hr + 1, r.begin());
+        } else {
+            auto c0 = pm::template _ntt_image<mod0>(n, p1, l1); pm::_ntt_product(c0, f0);
+            auto c1 = pm::template _ntt_image<mod1>(n, p1, l1); pm::_ntt_product(c1, f1);
+            auto c2 = pm::template _ntt_image<mod2>(n, p1, l1); pm::_ntt_product(c2, f2);
+            pm::_crt_ntt3(r.data(), lo, hr, c0, c1, c2);
+        }
+    }
+
+    // pr = p1 * p; see `polynom<mod>::mul`
+    void mul(polynom<mod> &pr, const polynom<mod> &p1, int lr = -1) const {
+        int l1 = p1.deg(); if (lr < 0) lr = l1 + l2;
+        l1 = std::min(l1, lr);
+        if (n == 0 || p1.size() == 0 || pm::next_pow2(l1 + l2 + 1) != n) {
+            polynom<mod>::mul(pr, p1, p, lr);
+        } else {
+            std::vector<mod> r(lr + 1, p1.ZERO_COEFF);
+            conv(r, p1.c.data(), l1, 0, std::min(lr, n - 1));
+            pr.ZERO_COEFF = p1.ZERO_COEFF;
+            pr.c.swap(r);
+        }
+    }
+
+    // pr = (p1 * p)[lo, hr]; see `polynom<mod>::mul_middle`
+    void mul_middle(polynom<mod> &pr, const polynom<mod> &p1, int lo, int hr) const {
+        int l1 = std::min(p1.deg(), hr);
+        if (n == 0 || p1.size() == 0 || pm::next_pow2(std::max(hr + 1, l1 + l2 - lo + 1)) != n) {
+            polynom<mod>::mul_middle(pr, p1, p, lo, hr);
+        } else {
+            std::vector<mod> r(hr - lo + 1, p1.ZERO_COEFF);
+            conv(r, p1.c.data(), l1, lo, hr);
+            pr.ZERO_COEFF = p1.ZERO_COEFF;
+            pr.c.swap(r);
+        }
+    }
+};
+
+/**
+ * polynom<modulo<int>> specialization
+ */
+template<int ID>
+struct polynom_mul<modulo<int, ID, modulo_storage::CONSTANT>> : polynom_mul_modulo_int<modulo<int, ID, modulo_storage::CONSTANT>> {};
+
+/**
+ * polynom<modulo<int>> specialization for the Montgomery form
+ *
+ * The generic schoolbook multiplication stays in the Montgomery form,
+ * whereas the specialized one would convert each coefficient.
+ */
+template<int ID>
+struct polynom_mul<modulo<int, ID, modulo_storage::MONTGOMERY>> : polynom_mul_modulo_int<modulo<int, ID, modulo_storage::MONTGOMERY>> {
+    typedef modulo<int, ID, modulo_storage::MONTGOMERY> mod;
+    static void _mul_long(mod* pr, int lr, const mod* p1, int l1, const mod* p2, int l2) {
+        polynom<mod>::_mul_long(pr, lr, p1, l1, p2, l2);
+    }
+};
+
+/**
+ * polynom<modulo<int>> middle product
+ *
+ * Shared by the `CONSTANT` and `MONTGOMERY` specializations below.
+ * Large products are done by a cyclic NTT convolution, that is only
+ * about the size of the longer factor, instead of the whole product.
+ */
+template<typename mod>
+struct polynom_mul_middle_modulo_int {
+    typedef polynom_mul<mod> pm;
+
+    static void impl(mod* pr, int lo, int hr, const mod* p1, int l1, const mod* p2, int l2) {
+        int n = pm::next_pow2(std::max(hr + 1, l1 + l2 - lo + 1));
+        int la = std::max(l1, l2), lb = std::min(l1, l2);
+        // the costs of a product of the transform size `n` versus the truncated product
+        double cost_ntt = pm::cost_ntt(n - 1, 0), cost_ntt3 = pm::cost_ntt3(n - 1, 0);
+        double cost = pm::cost_karatsuba(la, lb);
+        if (mod::M() < (1 << 30)) cost = std::min(cost, pm::cost_fft(la, lb));
+        if (lb >= 64 && n <= ntt_roots<mod>::get(mod(1)).max_size() && cost_ntt < pm::cost_karatsuba(la, lb)) {
+            auto c = pm::template _conv_ntt_prime<mod>(n, p1, l1, p2, l2);
+            std::copy(c.begin() + lo, c.begin() + hr + 1, pr);
+        } else if (lb >= 64 && n <= (1 << 23) && cost_ntt3 < cost) {
+            auto c0 = pm::template _conv_ntt_prime<typename pm::mod0>(n, p1, l1, p2, l2);
+            auto c1 = pm::template _conv_ntt_prime<typename pm::mod1>(n, p1, l1, p2, l2);
+            auto c2 = pm::template _conv_ntt_prime<typename pm::mod2>(n, p1, l1, p2, l2);
+            pm::_crt_ntt3(pr, lo, hr, c0, c1, c2);
+        } else {
+            polynom<mod>::_mul_middle(pr, lo, hr, p1, l1, p2, l2);
+        }
+    }
+};
+
+/**
+ * polynom<modulo<int>> middle product specializations
+ */
+template<int ID>
+struct polynom_mul_middle<modulo<int, ID, modulo_storage::CONSTANT>> : polynom_mul_middle_modulo_int<modulo<int, ID, modulo_storage::CONSTANT>> {};
+template<int ID>
+struct polynom_mul_middle<modulo<int, ID, modulo_storage::MONTGOMERY>> : polynom_mul_middle_modulo_int<modulo<int, ID, modulo_storage::MONTGOMERY>> {};
+
+/**
+ * polynom<modulo<int>> operand specializations
+ */
+template<int ID>
+class polynom_operand<modulo<int, ID, modulo_storage::CONSTANT>> : public polynom_operand_modulo_int<modulo<int, ID, modulo_storage::CONSTANT>> {
+public:
+    explicit polynom_operand(const polynom<modulo<int, ID, modulo_storage::CONSTANT>> &p, int l1 = -1) : polynom_operand_modulo_int<modulo<int, ID, modulo_storage::CONSTANT>>(p, l1) {}
+};
+template<int ID>
+class polynom_operand<modulo<int, ID, modulo_storage::MONTGOMERY>> : public polynom_operand_modulo_int<modulo<int, ID, modulo_storage::MONTGOMERY>> {
+public:
+    explicit polynom_operand(const polynom<modulo<int, ID, modulo_storage::MONTGOMERY>> &p, int l1 = -1) : polynom_operand_modulo_int<modulo<int, ID, modulo_storage::MONTGOMERY>>(p, l1) {}
+};
+
 } // math
 } // altruct
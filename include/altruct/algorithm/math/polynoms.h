@@ -1,6 +1,7 @@
 #pragma once
 
 #include "altruct/structure/math/polynom.h"
+#include "altruct/structure/math/series.h"
 #include "altruct/algorithm/math/recurrence.h"
 
 #include <vector>
@@ -102,5 +103,235 @@ polynom<T> polynom_sum(const polynom<T>& p) {
     return s;
 }
 
+/**
+ * Subproduct tree of the points `x`
+ *
+ * Node `k` covering the points `x[b]` to `x[e-1]` holds `Product[x - x[i], {i, b, e-1}]`.
+ * The root is node 1 covering all the points; the children of node `k` are
+ * nodes `2k` and `2k+1`, covering the first `(e-b)/2` and the remaining points.
+ *
+ * @param tree - the tree of at least `4 * x.size()` nodes
+ * @param k, b, e - the node to build and the range of points it covers
+ */
+template<typename T>
+void subproduct_tree(std::vector<polynom<T>>& tree, const std::vector<T>& x, int k, int b, int e) {
+    if (e - b == 1) {
+        tree[k] = polynom<T>{ -x[b], identityOf(x[b]) };
+        return;
+    }
+    int h = (b + e) / 2;
+    subproduct_tree(tree, x, k * 2, b, h);
+    subproduct_tree(tree, x, k * 2 + 1, h, e);
+    polynom<T>::mul(tree[k], tree[k * 2], tree[k * 2 + 1]);
+}
+template<typename T>
+std::vector<polynom<T>> subproduct_tree(const std::vector<T>& x) {
+    std::vector<polynom<T>> tree(std::max(x.size() * 4, size_t(2)));
+    if (!x.empty()) subproduct_tree(tree, x, 1, 0, (int)x.size());
+    return tree;
+}
+
+/**
+ * Evaluates `p` at the points `x[b]` to `x[e-1]` of the subproduct tree node `k`
+ *
+ * `p % tree[k]` is passed down to the children, down to the ranges of
+ * at most `horner_size` points, each of which is then evaluated by Horner.
+ */
+template<typename T>
+void multipoint_eval(std::vector<T>& r, const polynom<T>& p, const std::vector<polynom<T>>& tree, const std::vector<T>& x, int k, int b, int e, int horner_size = 32) {
+    if (e - b <= horner_size) {
+        for (int i = b; i < e; i++) {
+            r[i] = p.eval(x[i]);
+        }
+        return;
+    }
+    int h = (b + e) / 2;
+    polynom<T> q;
+    polynom<T>::mod(q, p, tree[k * 2]);
+    multipoint_eval(r, q, tree, x, k * 2, b, h, horner_size);
+    polynom<T>::mod(q, p, tree[k * 2 + 1]);
+    multipoint_eval(r, q, tree, x, k * 2 + 1, h, e, horner_size);
+}
+
+/**
+ * Evaluates the polynomial `p` at each of the points `x`
+ *
+ * Uses the subproduct tree of the points; O(M(n) log n) for `n` points
+ * and the degree of `p` in O(n), where M(n) is the multiplication cost.
+ */
+template<typename T>
+std::vector<T> multipoint_eval(const polynom<T>& p, const std::vector<T>& x) {
+    std::vector<T> r(x.size(), p.ZERO_COEFF);
+    if (x.empty()) return r;
+    auto tree = subproduct_tree(x);
+    multipoint_eval(r, p % tree[1], tree, x, 1, 0, (int)x.size());
+    return r;
+}
+
+/**
+ * Combines the weights `w[b]` to `w[e-1]` of the subproduct tree node `k` into
+ * `Sum[w[i] * tree[k] / (x - x[i]), {i, b, e-1}]`
+ */
+template<typename T>
+polynom<T> interpolate(const std::vector<T>& w, const std::vector<polynom<T>>& tree, int k, int b, int e) {
+    if (e - b == 1) {
+        return polynom<T>{ w[b] };
+    }
+    int h = (b + e) / 2;
+    polynom<T> r0 = interpolate(w, tree, k * 2, b, h);
+    polynom<T> r1 = interpolate(w, tree, k * 2 + 1, h, e);
+    r0 *= tree[k * 2 + 1];
+    r1 *= tree[k * 2];
+    return r0 += r1;
+}
+
+/**
+ * Lagrange interpolation
+ *
+ * Finds the polynomial `p` of degree less than `n` so that `p(x[i]) = y[i]`.
+ * Points `x` must be distinct. Uses the subproduct tree of the points:
+ *   `p = Sum[y[i] / m'(x[i]) * m / (x - x[i]), {i, 0, n-1}]`,
+ * where `m = Product[x - x[i], {i, 0, n-1}]`; O(M(n) log n)
+ */
+template<typename T>
+polynom<T> interpolate(const std::vector<T>& x, const std::vector<T>& y) {
+    if (x.empty()) return polynom<T>();
+    auto tree = subproduct_tree(x);
+    std::vector<T> w(x.size(), zeroOf(y[0]));
+    multipoint_eval(w, tree[1].derivative(), tree, x, 1, 0, (int)x.size());
+    for (int i = 0; i < (int)x.size(); i++) {
+        w[i] = y[i] / w[i];
+    }
+    return interpolate(w, tree, 1, 0, (int)x.size());
+}
+
+/**
+ * Taylor shift, `p(x + c)`
+ *
+ * `p(x + c) = Sum[x^k / k! * Sum[p[i] * i! * c^(i-k) / (i-k)!, {i, k, n}], {k, 0, n}]`,
+ * where the inner sums are a single convolution; O(M(n)), where `n` is the degree of `p`.
+ * `k!` must be invertible for each `k <= n`.
+ */
+template<typename T>
+polynom<T> taylor_shift(const polynom<T>& p, const T& c) {
+    int n = p.deg();
+    T e1 = identityOf(p.ZERO_COEFF);
+    std::vector<T> ifact(n + 1, e1);
+    for (int i = 1; i <= n; i++) ifact[i] = ifact[i - 1] * castOf(e1, i);
+    ifact[n] = e1 / ifact[n];
+    for (int i = n; i > 0; i--) ifact[i - 1] = ifact[i] * castOf(e1, i);
+    // a[n-i] = p[i] * i!, b[j] = c^j / j!
+    polynom<T> a(p.ZERO_COEFF), b(p.ZERO_COEFF);
+    a.c.assign(n + 1, p.ZERO_COEFF);
+    b.c.assign(n + 1, p.ZERO_COEFF);
+    T f = e1, cj = e1;
+    for (int i = 0; i <= n; i++) {
+        a[n - i] = p[i] * f;
+        b[i] = cj * ifact[i];
+        f *= castOf(e1, i + 1);
+        cj *= c;
+    }
+    polynom<T>::mul(a, a, b, n);
+    polynom<T> r(p.ZERO_COEFF);
+    r.c.resize(n + 1, p.ZERO_COEFF);
+    for (int k = 0; k <= n; k++) {
+        r[k] = a[n - k] * ifact[k];
+    }
+    return r;
+}
+
+/**
+ * Composition, `f(g(x)) mod x^n`
+ *
+ * Kinoshita & Li - Power Series Composition in Near-Linear Time:
+ * `f(g(x)) = [y^k] rev(f)(y) / (1 - y g(x))`, where `k` is the degree of `f`.
+ * The denominator `Q(x, y)` is repeatedly replaced by `Q(x, y) Q(-x, y)`, which only has
+ * even powers of `x`, halving the length in `x` and doubling the degree in `y`, as in
+ * the Bostan-Mori algorithm; then the coefficients are recovered on the way back up,
+ * where each level only needs a window of coefficients of `y` above the previous one.
+ * Everything is done modulo `y^(k+1)`. Bivariate products are done by the Kronecker
+ * substitution `y = x^L`. O(M(n + k) log(n)), where M(n) is the multiplication cost.
+ */
+template<typename T>
+polynom<T> compose(const polynom<T>& f, const polynom<T>& g, int n) {
+    T e0 = f.ZERO_COEFF, e1 = identityOf(e0);
+    if (n <= 0 || f.size() == 0) return polynom<T>(e0);
+    int k = f.deg();
+    // `qs[j][b * nx[j] + a]` is the coefficient of `x^a y^b` of the denominator at level `j`
+    std::vector<std::vector<T>> qs{ std::vector<T>(n * 2, e0) };
+    std::vector<int> nx{ n }, dy{ std::min(1, k) };
+    qs[0][0] = e1;
+    for (int a = 0; a < n && k > 0; a++) qs[0][n + a] = -g[a];
+    polynom<T> u(e0), v(e0);
+    while (nx.back() > 1) {
+        const auto& q = qs.back();
+        int N = nx.back(), d = dy.back(), L = N * 2 - 1;
+        int N2 = (N + 1) / 2, d2 = std::min(d * 2, k);
+        u.c.assign((d + 1) * L, e0);
+        v.c.assign((d + 1) * L, e0);
+        for (int b = 0; b <= d; b++) {
+            for (int a = 0; a < N; a++) {
+                u[b * L + a] = q[b * N + a];
+                v[b * L + a] = (a % 2) ? -q[b * N + a] : q[b * N + a];
+            }
+        }
+        polynom<T>::mul(u, u, v, (d2 + 1) * L - 1);
+        std::vector<T> q2((d2 + 1) * N2, e0);
+        for (int b = 0; b <= d2; b++) {
+            for (int a = 0; a < N2; a++) {
+                q2[b * N2 + a] = u[b * L + a * 2];
+            }
+        }
+        qs.push_back(std::move(q2));
+        nx.push_back(N2);
+        dy.push_back(d2);
+    }
+    // `w[j]` is the number of the coefficients of `y` needed at level `j`, up to `y^k`
+    int levels = (int)qs.size();
+    std::vector<int> w{ 1 };
+    for (int j = 0; j + 1 < levels; j++) w.push_back(std::min(w[j] + dy[j], k + 1));
+    // at the bottom, `x = 0`: [y^(k-w+1), y^k] of rev(f)(y) / Q(0, y)
+    polynom<T> fr(e0), q0(e0), h(e0);
+    fr.c.assign(f.c.rbegin() + (f.size() - 1 - k), f.c.rend());
+    q0.c.assign(qs.back().begin(), qs.back().end());
+    polynom<T>::divide(h, fr, q0, k + 1);
+    std::vector<T> r(h.c.end() - w.back(), h.c.end());
+    for (int j = levels - 2; j >= 0; j--) {
+        // [y^(k-w+1), y^k] of Q(-x, y) * H(x^2, y)
+        const auto& q = qs[j];
+        int N = nx[j], d = dy[j], L = N * 2 - 1, N2 = nx[j + 1], off = w[j + 1] - w[j];
+        u.c.assign((d + 1) * L, e0);
+        v.c.assign(w[j + 1] * L, e0);
+        for (int b = 0; b <= d; b++) {
+            for (int a = 0; a < N; a++) {
+                u[b * L + a] = (a % 2) ? -q[b * N + a] : q[b * N + a];
+            }
+        }
+        for (int b = 0; b < w[j + 1]; b++) {
+            for (int a = 0; a < N2; a++) {
+                v[b * L + a * 2] = r[b * N2 + a];
+            }
+        }
+        polynom<T>::mul_middle(u, u, v, off * L, (off + w[j]) * L - 1);
+        r.assign(w[j] * N, e0);
+        for (int b = 0; b < w[j]; b++) {
+            for (int a = 0; a < N; a++) {
+                r[b * N + a] = u[b * L + a];
+            }
+        }
+    }
+    polynom<T> fg(e0);
+    fg.c.swap(r);
+    return fg;
+}
+
+/**
+ * Composition of series, `f(g(x))`; see `compose` for polynomials
+ */
+template<typename T, int ID, int STORAGE_TYPE>
+series<T, ID, STORAGE_TYPE> compose(const series<T, ID, STORAGE_TYPE>& f, const series<T, ID, STORAGE_TYPE>& g) {
+    return series<T, ID, STORAGE_TYPE>(compose(f.p, g.p, f.size()), f.size());
+}
+
 } // math
 } // altruct
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "base.h"
+#include "altruct/algorithm/math/polynom_gcd.h"
 #include "altruct/structure/math/polynom.h"
 #include "altruct/structure/math/modulo.h"
 
@@ -39,6 +40,39 @@ polynom<T> linear_recurrence_coeff_to_poly(const std::vector<T> &f_coeff) {
     return p;
 }
 
+/**
+ * x^n % p(x), for a monic polynomial p(x)
+ *
+ * Above `polynom<T>::newton_div_threshold`, each squaring step is reduced
+ * by the Newton division, with `p` prepared once; see `polynom_divisor`.
+ */
+template<typename T, typename I>
+polynom<T> powx_mod(const polynom<T> &p, I n) {
+    T e0 = zeroOf(p[0]), e1 = identityOf(p[0]);
+    int L = p.deg();
+    if (L - 1 < polynom<T>::newton_div_threshold()) {
+        typedef moduloX<polynom<T>> polymod;
+        polynom<T> x = { e0, e1 };
+        return powT(polymod(x, p), n).v;
+    }
+    polynom_divisor<T> pd(p);
+    std::vector<int> bits;
+    for (; n > 0; n /= 2) bits.push_back(int(n % 2));
+    polynom<T> r(e1);
+    for (int k = (int)bits.size() - 1; k >= 0; k--) {
+        polynom<T>::mul(r, r, r);
+        polynom<T>::mod(r, r, pd);
+        if (bits[k]) {
+            // r * x % p
+            r.c.insert(r.c.begin(), e0);
+            T s = r[L];
+            for (int i = 0; i < L; i++) r[i] -= s * p[i];
+            r.resize(L);
+        }
+    }
+    return r;
+}
+
 /**
  * n-th element of a linear recurrence
  *
@@ -53,17 +87,131 @@ A linear_recurrence(const std::vector<T> &f_coeff, const std::vector<A> &f_init,
     T e0 = zeroOf(f_coeff[0]), e1 = identityOf(f_coeff[0]);
     int L = (int)f_coeff.size();
     // x^n % p(x)
-    typedef moduloX<polynom<T>> polymod;
     polynom<T> p = linear_recurrence_coeff_to_poly(f_coeff);
-    polynom<T> x = { e0, e1 };
-    polymod xn = powT(polymod(x, p), n);
+    polynom<T> xn = powx_mod(p, n);
     // f[n]
     A r = zeroOf(f_init[0]);
     for (int i = 0; i < L; i++) {
-        r += castOf(r, xn.v[i]) * f_init[i];
+        r += castOf(r, xn[i]) * f_init[i];
+    }
+    return r;
+}
+
+/**
+ * Bostan-Mori helpers
+ *
+ * f[n] = [x^n] P(x) / Q(x), where:
+ *   Q(x) = 1 - Sum[f_coeff[i] * x^(i+1), {i, 0, L-1}]
+ *   P(x) = f_init(x) * Q(x) % x^L
+ * Each step halves `n` by `P(x) / Q(x) = P(x) Q(-x) / V(x^2)`,
+ * where `V(x^2) = Q(x) Q(-x)` and so only the even or odd part of the numerator is kept.
+ */
+template<typename T>
+polynom<T> bostan_mori_denominator(const std::vector<T> &f_coeff) {
+    T e0 = zeroOf(f_coeff[0]), e1 = identityOf(f_coeff[0]);
+    int L = (int)f_coeff.size();
+    polynom<T> q(std::vector<T>(L + 1, e0));
+    q[0] = e1;
+    for (int i = 0; i < L; i++) {
+        q[i + 1] = -f_coeff[i];
+    }
+    return q;
+}
+template<typename T>
+polynom<T> bostan_mori_numerator(const std::vector<T> &f_init, const polynom<T> &q) {
+    int L = q.size() - 1;
+    polynom<T> p(f_init);
+    polynom<T>::mul(p, p, q, L - 1);
+    return p;
+}
+// Q(-x)
+template<typename T>
+polynom<T> bostan_mori_neg(const polynom<T> &q) {
+    polynom<T> r = q;
+    for (int i = 1; i < r.size(); i += 2) {
+        r[i] = -r[i];
     }
     return r;
 }
+// V(y), where V(x^2) = Q(x) Q(-x) = E(x^2)^2 - x^2 O(x^2)^2, for Q(x) = E(x^2) + x O(x^2)
+template<typename T>
+polynom<T> bostan_mori_halve(const polynom<T> &q) {
+    int L = q.size() - 1;
+    polynom<T> e(q.ZERO_COEFF), o(q.ZERO_COEFF);
+    for (int i = 0; i <= L; i += 2) e[i / 2] = q[i];
+    for (int i = 1; i <= L; i += 2) o[i / 2] = q[i];
+    polynom<T>::mul(e, e, e, L);
+    polynom<T>::mul(o, o, o, L - 1);
+    for (int i = 0; i < L; i++) e[i + 1] -= o[i];
+    e.resize(L + 1);
+    return e;
+}
+// P(x) := the `parity` part of P(x) Q(-x), where `qn` is Q(-x)
+template<typename T>
+void bostan_mori_step(polynom<T> &p, const polynom_operand<T> &qn, int parity) {
+    int L = p.size();
+    polynom<T>::mul(p, p, qn, L * 2 - 1);
+    for (int i = 0; i < L; i++) {
+        p[i] = p[i * 2 + parity];
+    }
+    p.resize(L);
+}
+
+/**
+ * n-th element of a linear recurrence, by the Bostan-Mori algorithm
+ *
+ * Same as `linear_recurrence`, but the initial values are of the same type as
+ * the coefficients. O(M(L) log n), with only two products of degree L per step.
+ *
+ * @param f_coeff - coefficients
+ * @param f_init - initial values
+ */
+template<typename T, typename I>
+T linear_recurrence_bostan_mori(const std::vector<T> &f_coeff, const std::vector<T> &f_init, I n) {
+    int L = (int)f_coeff.size();
+    polynom<T> q = bostan_mori_denominator(f_coeff);
+    polynom<T> p = bostan_mori_numerator(f_init, q);
+    for (; n > 0; n /= 2) {
+        bostan_mori_step(p, polynom_operand<T>(bostan_mori_neg(q), L - 1), int(n % 2));
+        q = bostan_mori_halve(q);
+    }
+    // q[0] is always 1
+    return p[0];
+}
+
+/**
+ * Elements of a linear recurrence at each of the given indices, by the Bostan-Mori algorithm
+ *
+ * The denominators do not depend on `n`, so they are computed, and
+ * prepared for multiplication, only once for all the indices.
+ * This leaves one product of degree L per step for each index.
+ *
+ * @param f_coeff - coefficients
+ * @param f_init - initial values
+ * @param vn - indices
+ */
+template<typename T, typename I>
+std::vector<T> linear_recurrence_bostan_mori(const std::vector<T> &f_coeff, const std::vector<T> &f_init, const std::vector<I> &vn) {
+    int L = (int)f_coeff.size();
+    polynom<T> q = bostan_mori_denominator(f_coeff);
+    polynom<T> p0 = bostan_mori_numerator(f_init, q);
+    std::vector<polynom_operand<T>> vqn;
+    std::vector<T> vr;
+    for (I n : vn) {
+        polynom<T> p = p0;
+        int k = 0;
+        for (; n > 0; n /= 2, k++) {
+            if (k == (int)vqn.size()) {
+                vqn.emplace_back(bostan_mori_neg(q), L - 1);
+                q = bostan_mori_halve(q);
+            }
+            bostan_mori_step(p, vqn[k], int(n % 2));
+        }
+        vr.push_back(p[0]);
+    }
+    // q[0] is always 1
+    return vr;
+}
 
 /**
  * The next element of a linear recurrence
@@ -134,6 +282,10 @@ std::vector<T> bernoulli_b(int n, T id = T(1)) {
  * Works for an arbitrary field. The field requirement means that all non-zero
  * elements need to have a multiplicative inverse.
  *
+ * The polynomial is the cofactor of the reversed sequence at the first remainder
+ * of degree less than L in the Euclidean algorithm on `x^2L` and the reversed
+ * sequence, which is found by the Half-GCD; O(M(L) log L).
+ *
  * @param a - the first 2L elements (or more) of the sequence,
  *            where L is the degree of the polynomial
  *
@@ -144,22 +296,15 @@ polynom<T> berlekamp_massey_poly(const std::vector<A>& a, T id = T(1)) {
     T e0 = zeroOf(id), e1 = identityOf(id);
     int n = (int)a.size() / 2;
     int m = 2 * n - 1;
-    polynom<A> R, R0, R1;
-    polynom<T> V, V0, V1, Q;
-    R0[m + 1] = identityOf(a[0]);
+    polynom<T> R0(e0), R1(e0);
+    R0[m + 1] = e1;
     for (int i = 0; i <= m; i++) {
-        R1[i] = a[m - i];
-    }
-    V0[0] = e0;
-    V1[0] = e1;
-    while (R1.deg() >= n) {
-        Q = R0 / R1;
-        R = R0 - Q * R1;
-        V = V0 - Q * V1;
-        V0 = V1; V1 = V;
-        R0 = R1; R1 = R;
+        R1[i] = castOf(id, a[m - i]);
     }
-    return V1 / V1[V1.deg()];
+    R1.normalize();
+    // the remainders of `x^2n` and `R1` are `R0 * U + R1 * V`
+    polynom<T> V1 = half_gcd(R0, R1).m[1][1];
+    return V1 / V1.leading_coeff();
 }
 
 /**
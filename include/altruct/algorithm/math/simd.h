@@ -0,0 +1,312 @@
+#pragma once
+
+#include "altruct/structure/math/modulo.h"
+
+#include <cstdint>
+#include <vector>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define ALTRUCT_AVX2
+#define ALTRUCT_AVX2_TARGET __attribute__((target("avx2")))
+#elif defined(_MSC_VER) && defined(_M_X64)
+#include <immintrin.h>
+#include <intrin.h>
+#define ALTRUCT_AVX2
+#define ALTRUCT_AVX2_TARGET
+#endif
+
+namespace altruct {
+namespace math {
+
+/**
+ * Whether the CPU and the OS support AVX2; detected once at runtime.
+ */
+inline bool cpu_has_avx2() {
+#if defined(ALTRUCT_AVX2) && defined(__GNUC__)
+    static const bool has = __builtin_cpu_supports("avx2");
+    return has;
+#elif defined(ALTRUCT_AVX2)
+    static const bool has = []{
+        int info[4];
+        __cpuid(info, 0); if (info[0] < 7) return false;
+        __cpuid(info, 1); if (!(info[2] & (1 << 27))) return false; // OSXSAVE
+        if ((_xgetbv(0) & 6) != 6) return false; // XMM and YMM state
+        __cpuidex(info, 7, 0); return (info[1] & (1 << 5)) != 0;
+    }();
+    return has;
+#else
+    return false;
+#endif
+}
+
+/**
+ * Whether the vectorized kernels are to be used.
+ * Defaults to `cpu_has_avx2()`; can be turned off to force the scalar code.
+ */
+inline bool& simd_enabled() {
+    static bool enabled = cpu_has_avx2();
+    return enabled;
+}
+
+/**
+ * Butterflies of the radix-2 transforms in `convolutions.h`
+ */
+struct simd_butterfly {
+    enum type {
+        HADAMARD, // (u, v) <-- (u + v, u - v)
+        PLUS,     // (u, v) <-- (u, v + u)
+        MINUS,    // (u, v) <-- (u, v - u)
+    };
+};
+
+/**
+ * Modulo types whose arrays can be processed as arrays of `uint32_t`.
+ *
+ * `supported` is true for `modulo<int, ID, CONSTANT>` and `modulo<int, ID, STATIC>`,
+ * as their only data member is the normalized `int` value.
+ */
+template<typename T>
+struct simd_modulo_traits {
+    static const bool supported = false;
+    static uint32_t M() { return 0; }
+};
+template<int ID>
+struct simd_modulo_traits<modulo<int, ID, modulo_storage::CONSTANT>> {
+    static const bool supported = true;
+    static uint32_t M() { return uint32_t(modulo<int, ID, modulo_storage::CONSTANT>::M()); }
+};
+template<int ID>
+struct simd_modulo_traits<modulo<int, ID, modulo_storage::STATIC>> {
+    static const bool supported = true;
+    static uint32_t M() { return uint32_t(modulo<int, ID, modulo_storage::STATIC>::M()); }
+};
+
+#if defined(ALTRUCT_AVX2)
+
+// modular arithmetic on 8 lanes of normalized values, `M < 2^31`
+ALTRUCT_AVX2_TARGET inline __m256i avx2_mod_add(__m256i x, __m256i y, __m256i m) {
+    __m256i r = _mm256_add_epi32(x, y);
+    return _mm256_min_epu32(r, _mm256_sub_epi32(r, m));
+}
+ALTRUCT_AVX2_TARGET inline __m256i avx2_mod_sub(__m256i x, __m256i y, __m256i m) {
+    __m256i r = _mm256_sub_epi32(x, y);
+    return _mm256_min_epu32(r, _mm256_add_epi32(r, m));
+}
+// x * y * 2^-32 mod M, for odd `M < 2^31` and `mi = M^-1 mod 2^32`
+ALTRUCT_AVX2_TARGET inline __m256i avx2_mod_mul_montgomery(__m256i x, __m256i y, __m256i m, __m256i mi) {
+    __m256i xy0 = _mm256_mul_epu32(x, y);
+    __m256i xy1 = _mm256_mul_epu32(_mm256_srli_epi64(x, 32), _mm256_srli_epi64(y, 32));
+    __m256i qm0 = _mm256_mul_epu32(_mm256_mul_epu32(xy0, mi), m);
+    __m256i qm1 = _mm256_mul_epu32(_mm256_mul_epu32(xy1, mi), m);
+    // low halves of `xy` and `qm` are equal, the difference of high halves is in (-M, M)
+    __m256i hi_xy = _mm256_blend_epi32(_mm256_srli_epi64(xy0, 32), xy1, 0xAA);
+    __m256i hi_qm = _mm256_blend_epi32(_mm256_srli_epi64(qm0, 32), qm1, 0xAA);
+    __m256i r = _mm256_sub_epi32(hi_xy, hi_qm);
+    return _mm256_min_epu32(r, _mm256_add_epi32(r, m));
+}
+
+// butterflies between `u[j]` and `v[j]` of `fast_radix2_dif_transform` with `n` a multiple of 8
+template<int KIND>
+ALTRUCT_AVX2_TARGET void avx2_mod_radix2_rows(uint32_t* f0, uint32_t* f1, int n, uint32_t M) {
+    const __m256i m = _mm256_set1_epi32(int(M));
+    for (int j = 0; j < n; j += 8) {
+        __m256i u = _mm256_loadu_si256((const __m256i*)(f0 + j));
+        __m256i v = _mm256_loadu_si256((const __m256i*)(f1 + j));
+        if (KIND == simd_butterfly::HADAMARD) {
+            _mm256_storeu_si256((__m256i*)(f0 + j), avx2_mod_add(u, v, m));
+            _mm256_storeu_si256((__m256i*)(f1 + j), avx2_mod_sub(u, v, m));
+        } else if (KIND == simd_butterfly::PLUS) {
+            _mm256_storeu_si256((__m256i*)(f1 + j), avx2_mod_add(v, u, m));
+        } else {
+            _mm256_storeu_si256((__m256i*)(f1 + j), avx2_mod_sub(v, u, m));
+        }
+    }
+}
+
+// the stages of `ntt_dif` and `ntt_dit`, with twiddles in the Montgomery form
+ALTRUCT_AVX2_TARGET inline void avx2_ntt_dif2_stage(uint32_t* a, int h, const uint32_t* roots, uint32_t M, uint32_t MI) {
+    const __m256i m = _mm256_set1_epi32(int(M)), mi = _mm256_set1_epi32(int(MI));
+    for (int j = 0; j < h; j += 8) {
+        __m256i u = _mm256_loadu_si256((const __m256i*)(a + j));
+        __m256i v = _mm256_loadu_si256((const __m256i*)(a + j + h));
+        __m256i w = _mm256_loadu_si256((const __m256i*)(roots + h + j));
+        _mm256_storeu_si256((__m256i*)(a + j), avx2_mod_add(u, v, m));
+        _mm256_storeu_si256((__m256i*)(a + j + h), avx2_mod_mul_montgomery(avx2_mod_sub(u, v, m), w, m, mi));
+    }
+}
+ALTRUCT_AVX2_TARGET inline void avx2_ntt_dif4_stage(uint32_t* data, int size, int q, const uint32_t* roots, uint32_t M, uint32_t MI) {
+    const __m256i m = _mm256_set1_epi32(int(M)), mi = _mm256_set1_epi32(int(MI));
+    const __m256i I = _mm256_set1_epi32(int(roots[3]));
+    for (uint32_t* a = data; a < data + size; a += q * 4) {
+        for (int j = 0; j < q; j += 8) {
+            __m256i w1 = _mm256_loadu_si256((const __m256i*)(roots + q * 2 + j));
+            __m256i w2 = _mm256_loadu_si256((const __m256i*)(roots + q + j));
+            __m256i w3 = avx2_mod_mul_montgomery(w1, w2, m, mi); // stays in the Montgomery form
+            __m256i a0 = _mm256_loadu_si256((const __m256i*)(a + j));
+            __m256i a1 = _mm256_loadu_si256((const __m256i*)(a + j + q));
+            __m256i a2 = _mm256_loadu_si256((const __m256i*)(a + j + q * 2));
+            __m256i a3 = _mm256_loadu_si256((const __m256i*)(a + j + q * 3));
+            __m256i b0 = avx2_mod_add(a0, a2, m), b1 = avx2_mod_add(a1, a3, m);
+            __m256i x = avx2_mod_sub(a0, a2, m), y = avx2_mod_mul_montgomery(avx2_mod_sub(a1, a3, m), I, m, mi);
+            _mm256_storeu_si256((__m256i*)(a + j), avx2_mod_add(b0, b1, m));
+            _mm256_storeu_si256((__m256i*)(a + j + q), avx2_mod_mul_montgomery(avx2_mod_sub(b0, b1, m), w2, m, mi));
+            _mm256_storeu_si256((__m256i*)(a + j + q * 2), avx2_mod_mul_montgomery(avx2_mod_add(x, y, m), w1, m, mi));
+            _mm256_storeu_si256((__m256i*)(a + j + q * 3), avx2_mod_mul_montgomery(avx2_mod_sub(x, y, m), w3, m, mi));
+        }
+    }
+}
+ALTRUCT_AVX2_TARGET inline void avx2_ntt_dit4_stage(uint32_t* data, int size, int q, const uint32_t* iroots, uint32_t M, uint32_t MI) {
+    const __m256i m = _mm256_set1_epi32(int(M)), mi = _mm256_set1_epi32(int(MI));
+    const __m256i iI = _mm256_set1_epi32(int(iroots[3]));
+    for (uint32_t* a = data; a < data + size; a += q * 4) {
+        for (int j = 0; j < q; j += 8) {
+            __m256i iw1 = _mm256_loadu_si256((const __m256i*)(iroots + q * 2 + j));
+            __m256i iw2 = _mm256_loadu_si256((const __m256i*)(iroots + q + j));
+            __m256i iw3 = avx2_mod_mul_montgomery(iw1, iw2, m, mi);
+            __m256i c0 = _mm256_loadu_si256((const __m256i*)(a + j));
+            __m256i c1 = avx2_mod_mul_montgomery(_mm256_loadu_si256((const __m256i*)(a + j + q)), iw2, m, mi);
+            __m256i c2 = avx2_mod_mul_montgomery(_mm256_loadu_si256((const __m256i*)(a + j + q * 2)), iw1, m, mi);
+            __m256i c3 = avx2_mod_mul_montgomery(_mm256_loadu_si256((const __m256i*)(a + j + q * 3)), iw3, m, mi);
+            __m256i p = avx2_mod_add(c0, c1, m), q1 = avx2_mod_sub(c0, c1, m);
+            __m256i r = avx2_mod_add(c2, c3, m), s = avx2_mod_mul_montgomery(avx2_mod_sub(c2, c3, m), iI, m, mi);
+            _mm256_storeu_si256((__m256i*)(a + j), avx2_mod_add(p, r, m));
+            _mm256_storeu_si256((__m256i*)(a + j + q), avx2_mod_add(q1, s, m));
+            _mm256_storeu_si256((__m256i*)(a + j + q * 2), avx2_mod_sub(p, r, m));
+            _mm256_storeu_si256((__m256i*)(a + j + q * 3), avx2_mod_sub(q1, s, m));
+        }
+    }
+}
+ALTRUCT_AVX2_TARGET inline void avx2_ntt_dit2_stage(uint32_t* a, int h, const uint32_t* iroots, uint32_t M, uint32_t MI) {
+    const __m256i m = _mm256_set1_epi32(int(M)), mi = _mm256_set1_epi32(int(MI));
+    for (int j = 0; j < h; j += 8) {
+        __m256i u = _mm256_loadu_si256((const __m256i*)(a + j));
+        __m256i w = _mm256_loadu_si256((const __m256i*)(iroots + h + j));
+        __m256i v = avx2_mod_mul_montgomery(_mm256_loadu_si256((const __m256i*)(a + j + h)), w, m, mi);
+        _mm256_storeu_si256((__m256i*)(a + j), avx2_mod_add(u, v, m));
+        _mm256_storeu_si256((__m256i*)(a + j + h), avx2_mod_sub(u, v, m));
+    }
+}
+// radix-2 butterflies between the rows `u` and `v` of `n` elements, `w` being the twiddles
+ALTRUCT_AVX2_TARGET inline void avx2_ntt_dif2_rows(uint32_t* u, uint32_t* v, int n, const uint32_t* w, uint32_t M, uint32_t MI) {
+    const __m256i m = _mm256_set1_epi32(int(M)), mi = _mm256_set1_epi32(int(MI));
+    for (int j = 0; j < n; j += 8) {
+        __m256i x = _mm256_loadu_si256((const __m256i*)(u + j));
+        __m256i y = _mm256_loadu_si256((const __m256i*)(v + j));
+        __m256i t = _mm256_loadu_si256((const __m256i*)(w + j));
+        _mm256_storeu_si256((__m256i*)(u + j), avx2_mod_add(x, y, m));
+        _mm256_storeu_si256((__m256i*)(v + j), avx2_mod_mul_montgomery(avx2_mod_sub(x, y, m), t, m, mi));
+    }
+}
+ALTRUCT_AVX2_TARGET inline void avx2_ntt_dit2_rows(uint32_t* u, uint32_t* v, int n, const uint32_t* iw, uint32_t M, uint32_t MI) {
+    const __m256i m = _mm256_set1_epi32(int(M)), mi = _mm256_set1_epi32(int(MI));
+    for (int j = 0; j < n; j += 8) {
+        __m256i x = _mm256_loadu_si256((const __m256i*)(u + j));
+        __m256i t = _mm256_loadu_si256((const __m256i*)(iw + j));
+        __m256i y = avx2_mod_mul_montgomery(_mm256_loadu_si256((const __m256i*)(v + j)), t, m, mi);
+        _mm256_storeu_si256((__m256i*)(u + j), avx2_mod_add(x, y, m));
+        _mm256_storeu_si256((__m256i*)(v + j), avx2_mod_sub(x, y, m));
+    }
+}
+
+#endif // ALTRUCT_AVX2
+
+/**
+ * Runtime dispatched kernels on arrays of normalized `uint32_t` values modulo `M < 2^31`
+ *
+ * Each function returns false if no vectorized implementation is available,
+ * in which case the caller is expected to fall back to the scalar code.
+ * Lengths must be multiples of 8.
+ */
+inline bool simd_mod_radix2_rows(uint32_t* u, uint32_t* v, int n, uint32_t M, simd_butterfly::type kind) {
+#if defined(ALTRUCT_AVX2)
+    if (!simd_enabled() || n % 8 != 0) return false;
+    if (kind == simd_butterfly::HADAMARD) avx2_mod_radix2_rows<simd_butterfly::HADAMARD>(u, v, n, M);
+    if (kind == simd_butterfly::PLUS) avx2_mod_radix2_rows<simd_butterfly::PLUS>(u, v, n, M);
+    if (kind == simd_butterfly::MINUS) avx2_mod_radix2_rows<simd_butterfly::MINUS>(u, v, n, M);
+    return true;
+#else
+    return false;
+#endif
+}
+
+/**
+ * Montgomery form twiddles for the vectorized NTT stages; `M` must be odd.
+ *
+ * `MI = M^-1 mod 2^32`; values are transformed as `x * 2^32 mod M`, so that
+ * the Montgomery product of a normalized value and a twiddle is normalized.
+ */
+struct simd_ntt_twiddles {
+    uint32_t M, MI;
+    std::vector<uint32_t> roots, iroots;
+    simd_ntt_twiddles() : M(0), MI(0) {}
+    template<typename T>
+    void assign(uint32_t _M, const std::vector<T>& _roots, const std::vector<T>& _iroots) {
+        montgomery<uint32_t> mg(_M);
+        M = _M, MI = 0 - mg.MI;
+        roots.resize(_roots.size());
+        iroots.resize(_iroots.size());
+        for (size_t i = 0; i < roots.size(); i++) roots[i] = mg.to(uint32_t(int(_roots[i].v)));
+        for (size_t i = 0; i < iroots.size(); i++) iroots[i] = mg.to(uint32_t(int(_iroots[i].v)));
+    }
+};
+
+inline bool simd_ntt_dif2_stage(uint32_t* a, int h, const simd_ntt_twiddles& tw) {
+#if defined(ALTRUCT_AVX2)
+    if (!simd_enabled() || h % 8 != 0) return false;
+    avx2_ntt_dif2_stage(a, h, tw.roots.data(), tw.M, tw.MI);
+    return true;
+#else
+    return false;
+#endif
+}
+inline bool simd_ntt_dif4_stage(uint32_t* a, int size, int q, const simd_ntt_twiddles& tw) {
+#if defined(ALTRUCT_AVX2)
+    if (!simd_enabled() || q % 8 != 0) return false;
+    avx2_ntt_dif4_stage(a, size, q, tw.roots.data(), tw.M, tw.MI);
+    return true;
+#else
+    return false;
+#endif
+}
+inline bool simd_ntt_dit4_stage(uint32_t* a, int size, int q, const simd_ntt_twiddles& tw) {
+#if defined(ALTRUCT_AVX2)
+    if (!simd_enabled() || q % 8 != 0) return false;
+    avx2_ntt_dit4_stage(a, size, q, tw.iroots.data(), tw.M, tw.MI);
+    return true;
+#else
+    return false;
+#endif
+}
+inline bool simd_ntt_dit2_stage(uint32_t* a, int h, const simd_ntt_twiddles& tw) {
+#if defined(ALTRUCT_AVX2)
+    if (!simd_enabled() || h % 8 != 0) return false;
+    avx2_ntt_dit2_stage(a, h, tw.iroots.data(), tw.M, tw.MI);
+    return true;
+#else
+    return false;
+#endif
+}
+
+// the butterflies of `ntt_dif_four_step` and `ntt_dit_four_step`, `k` is the offset of the twiddles
+inline bool simd_ntt_dif2_rows(uint32_t* u, uint32_t* v, int n, int k, const simd_ntt_twiddles& tw) {
+#if defined(ALTRUCT_AVX2)
+    if (!simd_enabled() || n % 8 != 0) return false;
+    avx2_ntt_dif2_rows(u, v, n, tw.roots.data() + k, tw.M, tw.MI);
+    return true;
+#else
+    return false;
+#endif
+}
+inline bool simd_ntt_dit2_rows(uint32_t* u, uint32_t* v, int n, int k, const simd_ntt_twiddles& tw) {
+#if defined(ALTRUCT_AVX2)
+    if (!simd_enabled() || n % 8 != 0) return false;
+    avx2_ntt_dit2_rows(u, v, n, tw.iroots.data() + k, tw.M, tw.MI);
+    return true;
+#else
+    return false;
+#endif
+}
+
+} // math
+} // altruct
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <exception>
+#include <thread>
+#include <vector>
+
+namespace altruct {
+namespace concurrency {
+
+/**
+ * The number of threads used by the parallelized algorithms.
+ * Defaults to the number of hardware threads; set to 1 to disable threading.
+ */
+inline int& default_num_threads() {
+    static int num_threads = std::max(1, (int)std::thread::hardware_concurrency());
+    return num_threads;
+}
+
+/**
+ * Splits the range `[begin, end)` into `num_threads` contiguous chunks of
+ * nearly equal length and calls `func(b, e)` for each chunk `[b, e)` on its own thread.
+ * The last chunk is processed by the calling thread; returns once all chunks are done.
+ *
+ * Suitable for uniform work only, there is no load balancing.
+ * Chunks are processed concurrently so `func` must not write to any shared state
+ * except to the disjoint parts of the output belonging to its chunk.
+ * If `func` throws, all the chunks are still waited for, and then
+ * the exception of the first such chunk is rethrown.
+ */
+template<typename F>
+void parallel_range(int begin, int end, F func, int num_threads = default_num_threads()) {
+    int len = end - begin;
+    num_threads = std::max(1, std::min(num_threads, len));
+    if (num_threads == 1) {
+        if (len > 0) func(begin, end);
+        return;
+    }
+    std::vector<std::exception_ptr> errors(num_threads);
+    auto run = [&errors](F& f, int i, int b, int e) {
+        try { f(b, e); } catch (...) { errors[i] = std::current_exception(); }
+    };
+    std::vector<std::thread> t;
+    // joins the started threads even if starting another one throws
+    struct joiner {
+        std::vector<std::thread>& t;
+        ~joiner() { for (auto& th : t) if (th.joinable()) th.join(); }
+    } join_all{ t };
+    for (int i = 0; i < num_threads - 1; i++) {
+        int b = begin + int(int64_t(len) * i / num_threads);
+        int e = begin + int(int64_t(len) * (i + 1) / num_threads);
+        t.emplace_back([=]() mutable { run(func, i, b, e); });
+    }
+    run(func, num_threads - 1, begin + int(int64_t(len) * (num_threads - 1) / num_threads), end);
+    for (auto& th : t) th.join();
+    for (auto& err : errors) if (err) std::rethrow_exception(err);
+}
+
+} // concurrency
+} // altruct
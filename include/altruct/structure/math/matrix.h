@@ -7,6 +7,8 @@
 namespace altruct {
 namespace math {
 
+template<typename T> struct matrix_mul;
+
 template<typename T>
 class matrix {
 public:
@@ -97,20 +99,27 @@ public:
         return zeroOf(*this) -= *this;
     }
 
-    // lhs.cols() must be equal to rhs.rows()
-    matrix& operator *= (const matrix &rhs) {
-        T e0 = zeroOf(a[0][0]);
-        int n = rows(), m = cols(), p = rhs.cols();
-        matrix t(n, p);
+    // mr = m1 * m2; O(n * m * p)
+    // `mr` must be of `m1.rows() x m2.cols()` and distinct from `m1` and `m2`
+    static void _mul_long(matrix &mr, const matrix &m1, const matrix &m2) {
+        T e0 = zeroOf(m1[0][0]);
+        int n = m1.rows(), m = m1.cols(), p = m2.cols();
         for (int i = 0; i < n; i++) {
             for (int j = 0; j < p; j++) {
                 T s = e0;
                 for (int k = 0; k < m; k++) {
-                    s += a[i][k] * rhs[k][j];
+                    s += m1[i][k] * m2[k][j];
                 }
-                t[i][j] = s;
+                mr[i][j] = s;
             }
         }
+    }
+
+    // lhs.cols() must be equal to rhs.rows()
+    // delegates to `matrix_mul<T>::impl`
+    matrix& operator *= (const matrix &rhs) {
+        matrix t(rows(), rhs.cols());
+        matrix_mul<T>::impl(t, *this, rhs);
         return swap(t);
     }
     matrix operator * (const matrix &rhs) const {
@@ -242,6 +251,22 @@ public:
     }
 };
 
+/**
+ * `matrix<T>` multiplication implementation.
+ *
+ * Specialize this template for a custom or tweaked implementation.
+ * `matrix<T>::_mul_long` is the provided generic implementation.
+ */
+template<typename T>
+struct matrix_mul {
+    // mr = m1 * m2; `m1.cols() == m2.rows()`
+    // `mr` is of `m1.rows() x m2.cols()`, and distinct from `m1` and `m2`,
+    // which may be the same instance
+    static void impl(matrix<T>& mr, const matrix<T>& m1, const matrix<T>& m2) {
+        matrix<T>::_mul_long(mr, m1, m2);
+    }
+};
+
 template<typename T, typename I>
 struct castT<matrix<T>, I> {
     static matrix<T> of(const I& x) {
@@ -3,10 +3,57 @@
 #include "altruct/algorithm/math/base.h"
 
 #include <type_traits>
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#endif
 
 namespace altruct {
 namespace math {
 
+// full width unsigned multiplication; returns the low word and stores the high word to `*hi`
+inline uint32_t mul_wide(uint32_t x, uint32_t y, uint32_t* hi) {
+    uint64_t r = uint64_t(x) * y;
+    *hi = uint32_t(r >> 32);
+    return uint32_t(r);
+}
+inline uint64_t mul_wide(uint64_t x, uint64_t y, uint64_t* hi) {
+#if defined(__SIZEOF_INT128__)
+    unsigned __int128 r = (unsigned __int128)x * y;
+    *hi = uint64_t(r >> 64);
+    return uint64_t(r);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    return _umul128(x, y, hi);
+#else
+    uint64_t x0 = uint32_t(x), x1 = x >> 32, y0 = uint32_t(y), y1 = y >> 32;
+    uint64_t p00 = x0 * y0, p01 = x0 * y1, p10 = x1 * y0, p11 = x1 * y1;
+    uint64_t m = (p00 >> 32) + uint32_t(p01) + uint32_t(p10);
+    *hi = p11 + (p01 >> 32) + (p10 >> 32) + (m >> 32);
+    return (m << 32) | uint32_t(p00);
+#endif
+}
+
+// full width unsigned division of `hi * 2^64 + lo` by `d`; requires `hi < d`
+// returns the quotient and stores the remainder to `*r`
+inline uint64_t div_wide(uint64_t hi, uint64_t lo, uint64_t d, uint64_t* r) {
+#if defined(__SIZEOF_INT128__)
+    unsigned __int128 n = ((unsigned __int128)hi << 64) | lo;
+    *r = uint64_t(n % d);
+    return uint64_t(n / d);
+#elif defined(_MSC_VER) && defined(_M_X64) && _MSC_VER >= 1920
+    return _udiv128(hi, lo, d, r);
+#else
+    uint64_t q = 0;
+    for (int i = 63; i >= 0; i--) {
+        uint64_t c = hi >> 63;
+        hi = (hi << 1) | (lo >> i & 1);
+        q <<= 1;
+        if (c || hi >= d) hi -= d, q |= 1;
+    }
+    *r = hi;
+    return q;
+#endif
+}
+
 // modulo normalization
 template<typename T>
 void modulo_normalize(T* v, const T& M) { *v %= M; }
@@ -43,7 +90,14 @@ I modulo_mul_int_long(I x, I y, I M) {
     return r;
 }
 inline int64_t modulo_mul(int64_t x, int64_t y, int64_t M) {
-    return ((x | y) >> 31 == 0) ? (x * y) % M : modulo_mul_int_long(x, y, M);
+    if ((x | y) >> 31 == 0) return (x * y) % M;
+    // same sign semantics as `(x * y) % M`
+    uint64_t ux = (x < 0) ? 0 - uint64_t(x) : uint64_t(x), uy = (y < 0) ? 0 - uint64_t(y) : uint64_t(y);
+    if (ux >= uint64_t(M)) ux %= uint64_t(M);
+    if (uy >= uint64_t(M)) uy %= uint64_t(M);
+    uint64_t hi, lo = mul_wide(ux, uy, &hi), r;
+    div_wide(hi, lo, uint64_t(M), &r);
+    return ((x < 0) != (y < 0)) ? -int64_t(r) : int64_t(r);
 }
 inline int32_t modulo_mul(int32_t x, int32_t y, int32_t M) {
     return (int64_t(x) * y) % M;
@@ -87,10 +141,139 @@ inline int64_t modulo_div(int64_t x, int64_t y, int64_t M) { return modulo_div_i
 inline int32_t modulo_div(int32_t x, int32_t y, int32_t M) { return modulo_div_int(x, y, M); }
 
 
+/**
+ * Montgomery reduction context for an odd modulus `M`
+ *
+ * A value `x` is represented by `x * R mod M`, where `R = 2^w` and `w` is
+ * the bit width of `U`. This allows multiplication without division.
+ * `M` must be odd and less than `2^(w-1)`.
+ *
+ * @param U - the underlying unsigned type, `uint32_t` or `uint64_t`
+ */
+template<typename U>
+struct montgomery {
+    U M;   // the modulus
+    U MI;  // -M^-1 mod R
+    U R2;  // R^2 mod M
+
+    montgomery(U M = 1) : M(M), MI(0), R2(0) {
+        if (M % 2 == 0) return; // even modulus is not supported
+        U inv = M; // Newton iteration, each step doubles the number of correct low bits
+        for (int i = 0; i < 6; i++) inv *= U(2) - M * inv;
+        MI = U(0) - inv;
+        U r1 = (U(0) - M) % M; // R mod M
+        R2 = r1;
+        for (int i = 0; i < int(sizeof(U) * 8); i++) {
+            R2 += R2; if (R2 >= M) R2 -= M;
+        }
+    }
+
+    // (hi * R + lo) * R^-1 mod M, requires `hi < M`
+    U reduce(U lo, U hi) const {
+        U m_hi; mul_wide(U(lo * MI), M, &m_hi);
+        U r = hi + m_hi + U(lo != 0); // lo + m_lo is either 0 or R, where m_lo is the discarded low half
+        return (r >= M) ? r - M : r;
+    }
+    U mul(U x, U y) const { U hi, lo = mul_wide(x, y, &hi); return reduce(lo, hi); }
+    U add(U x, U y) const { U r = x + y; return (r >= M) ? r - M : r; }
+    U sub(U x, U y) const { return (x >= y) ? x - y : x + (M - y); }
+    U to(U x) const { return mul(x, R2); }
+    U from(U r) const { return reduce(r, 0); }
+};
+
+/**
+ * Barrett reduction context for a runtime modulus `M`
+ *
+ * Replaces the division in `x * y % M` by multiplications with the
+ * precomputed reciprocal `floor((2^(2w) - 1) / M)`, where `w` is
+ * the bit width of `U`. `M` must be less than `2^(w-2)`.
+ *
+ * @param U - the underlying unsigned type, `uint32_t` or `uint64_t`
+ */
+template<typename U>
+struct barrett;
+
+template<>
+struct barrett<uint32_t> {
+    uint32_t M;
+    uint64_t MU;
+
+    barrett(uint32_t M = 1) : M(M), MU(~uint64_t(0) / M) {}
+
+    // a mod M
+    uint32_t reduce(uint64_t a) const {
+        uint64_t q; mul_wide(a, MU, &q);
+        uint64_t r = a - q * M;
+        while (r >= M) r -= M;
+        return uint32_t(r);
+    }
+    uint32_t mul(uint32_t x, uint32_t y) const { return reduce(uint64_t(x) * y); }
+};
+
+template<>
+struct barrett<uint64_t> {
+    uint64_t M;
+    uint64_t MU1, MU0;
+
+    barrett(uint64_t M = 1) : M(M), MU1(~uint64_t(0) / M) {
+        uint64_t r;
+        MU0 = div_wide(~uint64_t(0) % M, ~uint64_t(0), M, &r);
+    }
+
+    // (hi * 2^64 + lo) mod M, requires `hi < M`
+    uint64_t reduce(uint64_t lo, uint64_t hi) const {
+        // q = floor((hi * 2^64 + lo) * MU / 2^128)
+        uint64_t h00, h01, h10;
+        mul_wide(lo, MU0, &h00);
+        uint64_t l01 = mul_wide(lo, MU1, &h01);
+        uint64_t l10 = mul_wide(hi, MU0, &h10);
+        uint64_t mid = h00 + l01, c = (mid < l01);
+        mid += l10, c += (mid < l10);
+        uint64_t q = hi * MU1 + h01 + h10 + c;
+        uint64_t r = lo - q * M;
+        while (r >= M) r -= M;
+        return r;
+    }
+    uint64_t mul(uint64_t x, uint64_t y) const { uint64_t hi, lo = mul_wide(x, y, &hi); return reduce(lo, hi); }
+};
+
+/**
+ * Modulo multiplication context for a runtime modulus
+ *
+ * Integral types precompute a Barrett context for the modulus `M`, so that
+ * multiplications avoid the hardware division. `mul` takes the slow path
+ * if the context was built for another modulus.
+ * Other types delegate to `modulo_mul`.
+ *
+ * `STATIC` modulo members keep the context of their modulus, and `powT` of
+ * `STATIC` and `INSTANCE` modulo builds one for all its multiplications.
+ */
+template<typename T>
+struct modulo_reducer {
+    explicit modulo_reducer(const T& M = T()) {}
+    bool is_for(const T& M) const { return true; }
+    T mul(const T& x, const T& y, const T& M) const { return modulo_mul(x, y, M); }
+};
+template<typename I, typename U>
+struct modulo_reducer_int {
+    barrett<U> br; // for `M`, or for 1 if `M` is not supported
+    explicit modulo_reducer_int(I M = 0) : br(supported(M) ? U(M) : U(1)) {}
+    // too large moduli are not supported by `barrett`
+    static bool supported(I M) { return M > 0 && !(U(M) >> (sizeof(U) * 8 - 2)); }
+    bool is_for(I M) const { return br.M == (supported(M) ? U(M) : U(1)); }
+    I mul(I x, I y, I _M) const {
+        // denormalized operands, too large moduli and a context for another modulus take the slow path
+        if (br.M != U(_M) || U(x) >= U(_M) || U(y) >= U(_M)) return modulo_mul(x, y, _M);
+        return I(br.mul(U(x), U(y)));
+    }
+};
+template<> struct modulo_reducer<int32_t> : modulo_reducer_int<int32_t, uint32_t> { using modulo_reducer_int::modulo_reducer_int; };
+template<> struct modulo_reducer<int64_t> : modulo_reducer_int<int64_t, uint64_t> { using modulo_reducer_int::modulo_reducer_int; };
+
 // modulo storage type
 
 namespace modulo_storage {
-    enum type { INSTANCE, STATIC, CONSTANT };
+    enum type { INSTANCE, STATIC, CONSTANT, MONTGOMERY };
 }
 
 template<typename T, int ID, int STORAGE_TYPE>
@@ -99,22 +282,40 @@ struct modulo_members;
 template<typename T, int ID>
 struct modulo_members<T, ID, modulo_storage::INSTANCE> {
     T _M;
-    modulo_members(const T& _M = 0) : _M(_M) {}
+    modulo_members(const T& _M = 0) : _M(_M) {}
     const T& M() const { return _M; }
     T& M() { return _M; }
+    T mul(const T& x, const T& y) const { return modulo_mul(x, y, _M); }
 };
 
 template<typename T, int ID>
 struct modulo_members<T, ID, modulo_storage::STATIC> {
     static T _M;
+    static modulo_reducer<T> _reducer; // for `_M`, unless `_M` is changed via `M()`
     modulo_members(const T& _M = 0) {}
     static T& M() { return _M; }
+    // Changes the modulus and rebuilds the multiplication context.
+    // A modulus changed via `M()` is multiplied by the slow path.
+    static void set_M(const T& M) { _M = M; _reducer = modulo_reducer<T>(M); }
+    static T mul(const T& x, const T& y) { return _reducer.mul(x, y, _M); }
 };
 
 template<typename T, int ID>
 struct modulo_members<T, ID, modulo_storage::CONSTANT> {
     modulo_members(const T& _M = 0) {}
     static T M() { return T(ID); }
+    static T mul(const T& x, const T& y) { return modulo_mul(x, y, M()); }
+};
+
+template<typename T, int ID>
+struct modulo_members<T, ID, modulo_storage::MONTGOMERY> {
+    typedef montgomery<typename std::make_unsigned<T>::type> montgomery_type;
+    static montgomery_type _mg;
+    modulo_members(const T& _M = 0) {}
+    static montgomery_type& mg() { return _mg; }
+    static T M() { return T(_mg.M); }
+    // Changes the modulus. Existing instances become invalid.
+    static void set_M(const T& _M) { _mg = montgomery_type(_M); }
 };
 
 /**
@@ -142,6 +343,10 @@ struct modulo_members<T, ID, modulo_storage::CONSTANT> {
  *      This is both for performance reasons (avoids a check) and convenience
  *      as one can do `modx(v, M) * int(u)` in which case the second operand
  *      gets resolved to `modx(u, 0)` which has an invalid modulus 0.
+ *    MONTGOMERY - Like STATIC, but the value is kept in the Montgomery form
+ *      so that multiplication requires no division. M must be odd, and less
+ *      than 2^31 or 2^63 for 32-bit or 64-bit T respectively. Set M with
+ *      `set_M`; it defaults to ID. See the specialization below.
  */
 template<typename T, int ID, int STORAGE_TYPE = modulo_storage::STATIC>
 class modulo : public modulo_members<T, ID, STORAGE_TYPE> {
@@ -155,7 +360,7 @@ public:
     modulo() : my_modulo_members(1), v(zeroOf(M())) { if (STORAGE_TYPE != modulo_storage::INSTANCE) normalize(); }
     modulo(const T& v) : my_modulo_members(1), v(v) { if (STORAGE_TYPE != modulo_storage::INSTANCE) normalize(); }
     modulo(const T& v, const T& M) : my_modulo_members(M), v(v) { normalize(); }
-    modulo(const modulo& rhs) : my_modulo_members(rhs.M()), v(rhs.v) {}
+    modulo(const modulo& rhs) : my_modulo_members(rhs), v(rhs.v) {}
 
     void normalize() { modulo_normalize(&v, this->M()); }
 
@@ -175,18 +380,107 @@ public:
 
     modulo& operator += (const modulo &rhs) { v = modulo_add(v, rhs.v, this->M()); return *this; }
     modulo& operator -= (const modulo &rhs) { v = modulo_sub(v, rhs.v, this->M()); return *this; }
-    modulo& operator *= (const modulo &rhs) { v = modulo_mul(v, rhs.v, this->M()); return *this; }
+    modulo& operator *= (const modulo &rhs) { v = this->mul(v, rhs.v);               return *this; }
     modulo& operator /= (const modulo &rhs) { v = modulo_div(v, rhs.v, this->M()); return *this; }
     modulo& operator %= (const modulo &rhs) { v %= rhs.v;                          return *this; }
 
     modulo inv() const { return modulo_inv(v, this->M()); }
 };
 
+/**
+ * A value kept in the Montgomery form, `r = v * R mod M`.
+ *
+ * Converts from and to the ordinary representation implicitly,
+ * so that `.v` of a Montgomery modulo reads and assigns as usual.
+ */
+template<typename T, typename P>
+struct montgomery_value {
+    typedef typename std::make_unsigned<T>::type U;
+    U r;
+    montgomery_value() : r(0) {}
+    montgomery_value(const T& v) { *this = v; }
+    montgomery_value& operator = (T v) { modulo_normalize(&v, P::M()); r = P::mg().to(U(v)); return *this; }
+    operator T() const { return T(P::mg().from(r)); }
+};
+
+/**
+ * Modulo M arithmetics in the Montgomery form
+ *
+ * Interchangeable with the `STATIC` storage type. The conversion to and from
+ * the Montgomery form happens only on construction, casts and `v` access.
+ */
+template<typename T, int ID>
+class modulo<T, ID, modulo_storage::MONTGOMERY> : public modulo_members<T, ID, modulo_storage::MONTGOMERY> {
+    typedef modulo_members<T, ID, modulo_storage::MONTGOMERY> my_modulo_members;
+public:
+    montgomery_value<T, my_modulo_members> v;
+
+    modulo() {}
+    modulo(const T& v) : v(v) {}
+    modulo(const T& v, const T& M) : v(v) {}
+    modulo(const modulo& rhs) : v(rhs.v) {}
+
+    // constructs directly from the Montgomery form
+    static modulo from_montgomery(typename montgomery_value<T, my_modulo_members>::U r) { modulo t; t.v.r = r; return t; }
+
+    bool operator == (const modulo &rhs) const { return (v.r == rhs.v.r); }
+    bool operator != (const modulo &rhs) const { return (v.r != rhs.v.r); }
+    bool operator <  (const modulo &rhs) const { return (T(v) <  T(rhs.v)); }
+    bool operator >  (const modulo &rhs) const { return (T(v) >  T(rhs.v)); }
+    bool operator <= (const modulo &rhs) const { return (T(v) <= T(rhs.v)); }
+    bool operator >= (const modulo &rhs) const { return (T(v) >= T(rhs.v)); }
+
+    modulo  operator +  (const modulo &rhs) const { modulo t(*this); t += rhs; return t; }
+    modulo  operator -  (const modulo &rhs) const { modulo t(*this); t -= rhs; return t; }
+    modulo  operator -  ()                  const { return from_montgomery(this->mg().sub(0, v.r)); }
+    modulo  operator *  (const modulo &rhs) const { modulo t(*this); t *= rhs; return t; }
+    modulo  operator /  (const modulo &rhs) const { modulo t(*this); t /= rhs; return t; }
+    modulo  operator %  (const modulo &rhs) const { modulo t(*this); t %= rhs; return t; }
+
+    modulo& operator += (const modulo &rhs) { v.r = this->mg().add(v.r, rhs.v.r); return *this; }
+    modulo& operator -= (const modulo &rhs) { v.r = this->mg().sub(v.r, rhs.v.r); return *this; }
+    modulo& operator *= (const modulo &rhs) { v.r = this->mg().mul(v.r, rhs.v.r); return *this; }
+    modulo& operator /= (const modulo &rhs) { v = modulo_div(T(v), T(rhs.v), this->M()); return *this; }
+    modulo& operator %= (const modulo &rhs) { v = T(v) % T(rhs.v);                     return *this; }
+
+    modulo inv() const { return modulo_inv(T(v), this->M()); }
+};
+
 template<typename T>
 using moduloX = modulo<T, 0, modulo_storage::INSTANCE>;
 
+/**
+ * Exponentiation by squaring for a runtime modulus
+ *
+ * All the multiplications share a single `modulo_reducer` built for the modulus.
+ */
+template<typename T, int ID, int STORAGE_TYPE, typename I>
+modulo<T, ID, STORAGE_TYPE> modulo_reduced_power(modulo<T, ID, STORAGE_TYPE> x, I y) {
+    T M = x.M();
+    modulo_reducer<T> reducer(M);
+    T r = identityOf(x).v, b = x.v;
+    for (; y > 0; y /= 2) {
+        if (y % 2 != 0) r = reducer.mul(r, b, M);
+        b = reducer.mul(b, b, M);
+    }
+    x.v = r;
+    return x;
+}
+template<typename T, int ID, typename I>
+modulo<T, ID, modulo_storage::INSTANCE> powT(modulo<T, ID, modulo_storage::INSTANCE> x, I y) {
+    return modulo_reduced_power(x, y);
+}
+template<typename T, int ID, typename I>
+modulo<T, ID, modulo_storage::STATIC> powT(modulo<T, ID, modulo_storage::STATIC> x, I y) {
+    return modulo_reduced_power(x, y);
+}
+
 template<typename T, int ID>
 T modulo_members<T, ID, modulo_storage::STATIC>::_M = castOf<T>(ID);
+template<typename T, int ID>
+modulo_reducer<T> modulo_members<T, ID, modulo_storage::STATIC>::_reducer(castOf<T>(ID));
+template<typename T, int ID>
+typename modulo_members<T, ID, modulo_storage::MONTGOMERY>::montgomery_type modulo_members<T, ID, modulo_storage::MONTGOMERY>::_mg(castOf<T>(ID));
 
 template<typename T, int ID, typename I>
 struct castT<modulo<T, ID, modulo_storage::INSTANCE>, I> {
@@ -214,6 +508,35 @@ struct castT<modulo<T, ID, STORAGE_TYPE>, I> {
 template<typename T, int ID, int STORAGE_TYPE>
 struct castT<modulo<T, ID, STORAGE_TYPE>, modulo<T, ID, STORAGE_TYPE>> : nopCastT<modulo<T, ID, STORAGE_TYPE>>{};
 
+template<typename T, int ID, typename I>
+struct castT<modulo<T, ID, modulo_storage::MONTGOMERY>, I> {
+    typedef modulo<T, ID, modulo_storage::MONTGOMERY> mod;
+    static mod of(const I& x) {
+        return mod(castOf<T>(x % mod::M()));
+    }
+    static mod of(const mod& ref, const I& x) {
+        return of(x);
+    }
+};
+template<typename T, int ID>
+struct castT<modulo<T, ID, modulo_storage::MONTGOMERY>, modulo<T, ID, modulo_storage::MONTGOMERY>> : nopCastT<modulo<T, ID, modulo_storage::MONTGOMERY>>{};
+
+template<typename T, int ID>
+struct identityT<modulo<T, ID, modulo_storage::MONTGOMERY>> {
+    typedef modulo<T, ID, modulo_storage::MONTGOMERY> mod;
+    static mod of(const mod& x) {
+        return mod::from_montgomery(mod::mg().to(1));
+    }
+};
+
+template<typename T, int ID>
+struct zeroT<modulo<T, ID, modulo_storage::MONTGOMERY>> {
+    typedef modulo<T, ID, modulo_storage::MONTGOMERY> mod;
+    static mod of(const mod& x) {
+        return mod::from_montgomery(0);
+    }
+};
+
 template<typename T, int ID, int STORAGE_TYPE>
 struct identityT<modulo<T, ID, STORAGE_TYPE>> {
     typedef modulo<T, ID, STORAGE_TYPE> mod;
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "altruct/algorithm/math/base.h"
+#include <iterator>
 #include <limits>
 #include <type_traits>
 #include <vector>
@@ -10,9 +11,90 @@ namespace altruct {
 namespace math {
 
 template<typename T> struct polynom_mul;
+template<typename T> struct polynom_mul_middle;
+template<typename T> class polynom_operand;
+template<typename T> class polynom_divisor;
+template<typename T> struct modulo_reducer;
+
+/**
+ * Scratch space for the polynomial multiplication
+ *
+ * A bump arena of coefficients, one per thread. Buffers are taken from its top
+ * within a `frame`, and are all given back when the frame ends, so frames must
+ * nest. The space is kept in blocks that are never reallocated, so the buffers
+ * already taken stay valid should a new block be needed. Once the arena is
+ * empty again, the blocks are merged into one, so that the following uses of
+ * the same size perform no heap allocation at all.
+ */
+template<typename T>
+class polynom_scratch {
+    std::vector<std::vector<T>> blocks;
+    int block = 0;          // the block the top is in
+    int top = 0;            // the offset of the top within the block
+
+public:
+    int allocations = 0;    // the number of heap allocations so far
+
+    static polynom_scratch& local() { thread_local polynom_scratch s; return s; }
+
+    int capacity() const { int c = 0; for (const auto& b : blocks) c += (int)b.size(); return c; }
+
+    // ensures that `n` coefficients can be taken without a heap allocation
+    void reserve(int n, const T& ZERO_COEFF) {
+        while (block < (int)blocks.size() && top + n > (int)blocks[block].size()) block++, top = 0;
+        if (block < (int)blocks.size()) return;
+        int sz = blocks.empty() ? 0 : (int)blocks.back().size();
+        blocks.emplace_back(std::max(n, sz * 2), ZERO_COEFF);
+        allocations++;
+    }
+
+    // takes a buffer of `n` coefficients; its content is unspecified
+    T* take(int n, const T& ZERO_COEFF) {
+        reserve(n, ZERO_COEFF);
+        T* p = blocks[block].data() + top;
+        top += n;
+        return p;
+    }
+
+    // frees the space, once no frame is active
+    void clear() { if (block == 0 && top == 0) blocks.clear(); }
+
+    /**
+     * Gives back all the buffers taken within its lifetime
+     */
+    class frame {
+        polynom_scratch& s;
+        int block, top;
+    public:
+        explicit frame(int n, const T& ZERO_COEFF) : s(local()), block(s.block), top(s.top) { s.reserve(n, ZERO_COEFF); }
+        frame(const frame&) = delete;
+        frame& operator=(const frame&) = delete;
+        ~frame() { s.block = block, s.top = top; if (block == 0 && top == 0) s.merge(); }
+        T* take(int n, const T& ZERO_COEFF) { return s.take(n, ZERO_COEFF); }
+    };
+
+private:
+    void merge() {
+        if (blocks.size() <= 1) return;
+        std::vector<T> b;
+        b.reserve(capacity());
+        for (auto& bl : blocks) std::move(bl.begin(), bl.end(), std::back_inserter(b));
+        blocks.clear();
+        blocks.push_back(std::move(b));
+        allocations++;
+    }
+};
 
 /**
  * Polynomial with coefficients in T.
+ *
+ * The representation is normalized when there are no zero coefficients above
+ * the leading one, in which case `deg()` and `leading_coeff()` take O(1) instead
+ * of a scan from the top. The arithmetic operations keep their results normalized,
+ * except for the ones of an explicitly requested length, such as `mul` with `lr`
+ * and `mul_middle`, and `quot_rem` of a fixed layout. Note that the non-const
+ * `operator []` grows the polynomial as needed, and that zeroing the leading
+ * coefficient denormalizes it; `normalize()` trims the zero coefficients.
  */
 template<typename T>
 class polynom {
@@ -37,6 +119,7 @@ public:
 
     polynom& swap(polynom &rhs) { std::swap(ZERO_COEFF, rhs.ZERO_COEFF); c.swap(rhs.c); return *this; }
     polynom& shrink_to_fit() { c.resize(deg() + 1, ZERO_COEFF); return *this; }
+    polynom& normalize() { int l = deg(); if (size() > l + 1) c.resize(l + 1); return *this; }
     polynom& reserve(int sz) { if (sz > size()) c.resize(sz, ZERO_COEFF); return *this; }
     polynom& resize(int sz) { if (sz != size()) c.resize(sz, ZERO_COEFF); return *this; }
     polynom& resize(int sz, const T& _ZERO_COEFF) { ZERO_COEFF = _ZERO_COEFF; return resize(sz); }
@@ -48,6 +131,7 @@ public:
     int deg() const { for (int i = size() - 1; i > 0; i--) if (!(c[i] == ZERO_COEFF)) return i; return 0; }
     int lowest() const { for (int i = 0; i < size(); i++) if (!(c[i] == ZERO_COEFF)) return i; return 0; }
     const T& leading_coeff() const { return at(deg()); }
+    bool is_normalized() const { return size() <= 1 || !(c.back() == ZERO_COEFF); }
     bool is_power() const { return lowest() == deg() && leading_coeff() == identityOf(ZERO_COEFF); }
 
     // compares p1 and p2; O(l1 + l2)
@@ -66,7 +150,7 @@ public:
         int lr = p1.deg();
         pr.resize(lr + 1, p1.ZERO_COEFF);
         for (int i = 0; i <= lr; i++) {
-            pr[i] = -p1[i];
+            pr.c[i] = -p1.at(i);
         }
     }
 
@@ -76,8 +160,10 @@ public:
         int l1 = p1.deg(), l2 = p2.deg(); int lr = std::max(l1, l2);
         pr.resize(lr + 1, p1.ZERO_COEFF);
         for (int i = 0; i <= lr; i++) {
-            pr[i] = p1[i] + p2[i];
+            pr.c[i] = p1.at(i) + p2.at(i);
         }
+        // the leading coefficients may only cancel out if of the same degree
+        if (l1 == l2) pr.normalize();
     }
 
     // pr = p1 - p2; O(l1 + l2)
@@ -86,8 +172,10 @@ public:
         int l1 = p1.deg(), l2 = p2.deg(); int lr = std::max(l1, l2);
         pr.resize(lr + 1, p1.ZERO_COEFF);
         for (int i = 0; i <= lr; i++) {
-            pr[i] = p1[i] - p2[i];
+            pr.c[i] = p1.at(i) - p2.at(i);
         }
+        // the leading coefficients may only cancel out if of the same degree
+        if (l1 == l2) pr.normalize();
     }
 
     // pr[lm + 1 : lr] = 0; O(l)
@@ -122,37 +210,45 @@ public:
         }
     }
 
+    // the scratch space needed by `_mul_karatsuba`, including all its recursive calls
+    static int _karatsuba_scratch(int lr) { return 6 * (lr + 1); }
+
     // pr = p1 * p2; O(lr ^ 1.59); or more accurate: O(l1 * l2 ^ 0.59)
     // `0 <= l2 <= l1 <= lr <= l1 + l2` must hold
     // it is allowed for `p1`, `p2` and `pr` to be the same instance
+    // the temporaries are taken from `polynom_scratch<T>`, sized for the whole recursion at once
     static void _mul_karatsuba(T* pr, int lr, const T* p1, int l1, const T* p2, int l2) {
         auto ZERO_COEFF = zeroOf(*p1);
         int k = l1 / 2 + 1; // k > l1 - k >= 0
         if (l2 == 0) {
             for (int i = lr; i >= 0; i--) pr[i] = p1[i] * p2[0];
         } else if (l2 < k) {
-            std::vector<T> MM(lr - k + 1, ZERO_COEFF);
-            _mul(MM.data(), lr - k, p1 + k, l1 - k, p2, l2);
+            typename polynom_scratch<T>::frame ws(_karatsuba_scratch(lr), ZERO_COEFF);
+            T* MM = ws.take(lr - k + 1, ZERO_COEFF);
+            _mul(MM, lr - k, p1 + k, l1 - k, p2, l2);
             _mul(pr, std::min(lr, l2 + k - 1), p1, k - 1, p2, l2);
             _zero(pr, l2 + k - 1, lr, ZERO_COEFF);
-            _add_to(pr + k, MM.data(), lr - k);
+            _add_to(pr + k, MM, lr - k);
         } else {
-            std::vector<T> S1(p1, p1 + k);
-            _add_to(S1.data(), p1 + k, l1 - k);
-            std::vector<T> S2(p2, p2 + k);
-            _add_to(S2.data(), p2 + k, l2 - k);
+            typename polynom_scratch<T>::frame ws(_karatsuba_scratch(lr), ZERO_COEFF);
+            T* S1 = ws.take(k, ZERO_COEFF);
+            std::copy(p1, p1 + k, S1);
+            _add_to(S1, p1 + k, l1 - k);
+            T* S2 = ws.take(k, ZERO_COEFF);
+            std::copy(p2, p2 + k, S2);
+            _add_to(S2, p2 + k, l2 - k);
             int mm_l = std::min(lr - k, k - 1 + k - 1);
-            std::vector<T> MM(mm_l + 1);
-            _mul(MM.data(), mm_l, S1.data(), k - 1, S2.data(), k - 1);
+            T* MM = ws.take(mm_l + 1, ZERO_COEFF);
+            _mul(MM, mm_l, S1, k - 1, S2, k - 1);
             int hh_l = std::min(mm_l, l1 - k + l2 - k);
-            std::vector<T> HH(hh_l + 1, ZERO_COEFF);
-            _mul(HH.data(), hh_l, p1 + k, l1 - k, p2 + k, l2 - k);
+            T* HH = ws.take(hh_l + 1, ZERO_COEFF);
+            _mul(HH, hh_l, p1 + k, l1 - k, p2 + k, l2 - k);
             _mul(pr, k - 1 + k - 1, p1, k - 1, p2, k - 1);
             _zero(pr, k - 1 + k - 1, lr, ZERO_COEFF);
-            _sub_from(MM.data(), pr, std::min(mm_l, k - 1 + k - 1));
-            _sub_from(MM.data(), HH.data(), hh_l);
-            _add_to(pr + k, MM.data(), mm_l);
-            _add_to(pr + k + k, HH.data(), lr - k - k);
+            _sub_from(MM, pr, std::min(mm_l, k - 1 + k - 1));
+            _sub_from(MM, HH, hh_l);
+            _add_to(pr + k, MM, mm_l);
+            _add_to(pr + k + k, HH, lr - k - k);
         }
     }
 
@@ -166,6 +262,16 @@ public:
         polynom_mul<T>::impl(pr, lr, p1, l1, p2, l2);
     }
 
+    // pr[i - lo] = (p1 * p2)[i], for `lo <= i <= hr`; by the product truncated to `hr`
+    // `0 <= lo <= hr <= l1 + l2` and `l1, l2 <= hr` must hold
+    static void _mul_middle(T* pr, int lo, int hr, const T* p1, int l1, const T* p2, int l2) {
+        auto ZERO_COEFF = zeroOf(*p1);
+        typename polynom_scratch<T>::frame ws(hr + 1 + _karatsuba_scratch(hr), ZERO_COEFF);
+        T* t = ws.take(hr + 1, ZERO_COEFF);
+        _mul(t, hr, p1, l1, p2, l2);
+        std::copy(t + lo, t + hr + 1, pr);
+    }
+
     // pr = p1 * p2;
     // it is allowed for `p1`, `p2` and `pr` to be the same instance
     // @param lr - the required degree of the resulting polynomial;
@@ -180,17 +286,129 @@ public:
         }
     }
 
-    // pr = p1 % p2 | p1 / p2; O((l1 - lm) * lm)
+    // pr = p1 * p2, where `p2` is prepared for repeated multiplication;
+    // it is allowed for `p1` and `pr` to be the same instance
+    // @param lr - the required degree of the resulting polynomial;
+    //             if -1, the result will be of degree l1 + l2
+    static void mul(polynom &pr, const polynom &p1, const polynom_operand<T> &p2, int lr = -1) {
+        p2.mul(pr, p1, lr);
+    }
+
+    // pr = (p1 * p2)[lo, hr]; the middle product
+    // coefficients of `p1 * p2` from `lo` to `hr` inclusive, shifted down by `lo`
+    // it is allowed for `p1`, `p2` and `pr` to be the same instance
+    // `0 <= lo <= hr` must hold
+    static void mul_middle(polynom &pr, const polynom &p1, const polynom &p2, int lo, int hr) {
+        int l1 = std::min(p1.deg(), hr), l2 = std::min(p2.deg(), hr);
+        std::vector<T> r(hr - lo + 1, p1.ZERO_COEFF);
+        if (p1.size() != 0 && p2.size() != 0 && lo <= l1 + l2) {
+            polynom_mul_middle<T>::impl(r.data(), lo, std::min(hr, l1 + l2), p1.c.data(), l1, p2.c.data(), l2);
+        }
+        pr.ZERO_COEFF = p1.ZERO_COEFF;
+        pr.c.swap(r);
+    }
+
+    // pr = (p1 * p2)[lo, hr], where `p2` is prepared for repeated multiplication
+    // it is allowed for `p1` and `pr` to be the same instance
+    static void mul_middle(polynom &pr, const polynom &p1, const polynom_operand<T> &p2, int lo, int hr) {
+        p2.mul_middle(pr, p1, lo, hr);
+    }
+
+    // pr = 1 / p1 (mod x^n); O(M(n))
+    // `p1[0]` must be invertible
+    // it is allowed for `p1` and `pr` to be the same instance
+    static void inverse(polynom &pr, const polynom &p1, int n) {
+        polynom r(identityOf(p1.ZERO_COEFF) / p1[0]), e(p1.ZERO_COEFF);
+        for (int l = 1; l < n; l *= 2) {
+            // p1 * r = 1 + e * x^l + O(x^2l), hence 1/p1 = r - e * r * x^l + O(x^2l)
+            // `e` is the middle product, and both products are by `r` of the same size
+            int m = std::min(n, l * 2);
+            polynom_operand<T> ro(r, l - 1);
+            e.c.assign(p1.c.begin(), p1.c.begin() + std::min(m, p1.size()));
+            mul_middle(e, e, ro, l, m - 1);
+            mul(e, e, ro, m - l - 1);
+            for (int i = m - 1; i >= l; i--) {
+                r[i] = -e[i - l];
+            }
+        }
+        r.resize(n);
+        pr.swap(r);
+    }
+
+    // pr = p1 / p2 (mod x^n); O(M(n))
+    // `p2[0]` must be invertible and `n >= 1`
+    // the inverse is only computed to (n + 1) / 2 terms, the last Newton step
+    // is merged with the product instead, see A.H. Karp & P. Markstein
+    // it is allowed for `p1`, `p2` and `pr` to be the same instance
+    static void divide(polynom &pr, const polynom &p1, const polynom &p2, int n) {
+        int h = (n + 1) / 2;
+        polynom g, q(p1.ZERO_COEFF), e(p1.ZERO_COEFF);
+        inverse(g, p2, h);
+        polynom_operand<T> go(g, h - 1);
+        q.c.assign(p1.c.begin(), p1.c.begin() + std::min(h, p1.size()));
+        mul(q, q, go, h - 1);
+        if (n > h) {
+            // p1 - p2 * q = e * x^h + O(x^n), hence p1 / p2 = q + e * g * x^h + O(x^n)
+            e.c.assign(p2.c.begin(), p2.c.begin() + std::min(n, p2.size()));
+            mul_middle(e, e, q, h, n - 1);
+            for (int i = h; i < n; i++) {
+                e[i - h] = p1.at(i) - e[i - h];
+            }
+            mul(e, e, go, n - h - 1);
+            q.resize(n);
+            for (int i = h; i < n; i++) {
+                q[i] = e[i - h];
+            }
+        }
+        pr.swap(q);
+    }
+
+    // the degree of both the divisor and the quotient from which
+    // the division is done by the Newton iteration instead of the long division
+    static int& newton_div_threshold() { static int threshold = 256; return threshold; }
+
+    // pr = p1 % pm | p1 / pm; O(M(l1))
+    // by the Newton iteration on the reversed polynomials:
+    // rev(q) = rev(p1) * pmi (mod x^(l1 - lm + 1)), where `pmi` = 1 / rev(pm) (mod x^(l1 - lm + 1))
+    // r = p1 - q * pm (mod x^lm)
+    // `pmi` and `pm` are prepared operands; the layout of `pr` is the same as of `quot_rem`
+    // it is allowed for `p1` and `pr` to be the same instance
+    // `pr` and `pm` must not be the same instance
+    static void _quot_rem_newton(polynom &pr, const polynom &p1, int l1, const polynom_operand<T> &pmi, const polynom_operand<T> &pm, int lm) {
+        int lr = l1 - lm;
+        polynom q(p1.ZERO_COEFF), t(p1.ZERO_COEFF);
+        q.c.assign(p1.c.rend() - l1 - 1, p1.c.rend() - lm);
+        mul(q, q, pmi, lr);
+        std::reverse(q.c.begin(), q.c.end());
+        mul(t, q, pm, lm - 1);
+        pr = p1;
+        for (int i = 0; i < lm; i++) {
+            pr[i] -= t[i];
+        }
+        for (int i = 0; i <= lr; i++) {
+            pr[lm + i] = q[i];
+        }
+    }
+
+    // pr = p1 % p2 | p1 / p2; O((l1 - lm) * lm), or O(M(l1)) above `newton_div_threshold`
     // it is allowed for `p1` and `pr` to be the same instance
     // `pr` and `pm` must not be the same instance
     static void quot_rem(polynom &pr, const polynom &p1, const polynom &pm) {
         int l1 = p1.deg(), lm = pm.deg(); int lr = l1 - lm;
+        if (lr >= 0 && std::min(lr, lm) >= newton_div_threshold() && !pm.is_power()) {
+            polynom pmi(p1.ZERO_COEFF);
+            pmi.c.assign(pm.c.rend() - lm - 1, pm.c.rend() - std::max(lm - lr, 0));
+            inverse(pmi, pmi, lr + 1);
+            _quot_rem_newton(pr, p1, l1, polynom_operand<T>(pmi, lr), polynom_operand<T>(pm, std::min(lr, lm - 1)), lm);
+            return;
+        }
         pr = p1;
         if (lr < 0 || pm.is_power()) return;
+        T* r = pr.c.data(); const T* m = pm.c.data();
         for (int i = l1; i >= lm; i--) {
-            T s = pr[i] /= pm[lm]; if (s == p1.ZERO_COEFF) continue;
+            T s = r[i] /= m[lm]; if (s == p1.ZERO_COEFF) continue;
             for (int j = 1; j <= lm; j++) {
-                pr[i - j] = pr[i - j] - s * pm[lm - j];
+                r[i - j] -= s * m[lm - j];
             }
         }
     }
@@ -203,9 +421,10 @@ public:
         if (lr < 0) { pr.c.clear(); return; }
         quot_rem(pr, p1, pm);
         for (int i = 0; i <= lr; i++) {
-            pr[i] = pr[i + lm];
+            pr.c[i] = pr.c[i + lm];
         }
         pr.resize(lr + 1);
+        pr.normalize();
     }
 
     // pr = p1 % pm; O((l1 - lm) * lm)
@@ -215,6 +434,22 @@ public:
         int l1 = p1.deg(), lm = pm.deg(); int lr = lm - 1;
         quot_rem(pr, p1, pm);
         if (lr < l1) pr.resize(lr + 1);
+        pr.normalize();
+    }
+
+    // pr = p1 % pm | p1 / pm, with `pm` prepared for repeated division; see `polynom_divisor`
+    // it is allowed for `p1` and `pr` to be the same instance
+    static void quot_rem(polynom &pr, const polynom &p1, const polynom_divisor<T> &pm) {
+        pm.quot_rem(pr, p1);
+    }
+
+    // pr = p1 % pm, with `pm` prepared for repeated division; see `polynom_divisor`
+    // it is allowed for `p1` and `pr` to be the same instance
+    static void mod(polynom &pr, const polynom &p1, const polynom_divisor<T> &pm) {
+        int l1 = p1.deg(), lr = pm.p.deg() - 1;
+        quot_rem(pr, p1, pm);
+        if (lr < l1) pr.resize(lr + 1);
+        pr.normalize();
     }
 
     // pr = p1 * s; O(l1)
@@ -223,8 +458,9 @@ public:
         int lr = p1.deg();
         pr.resize(lr + 1, p1.ZERO_COEFF);
         for (int i = 0; i <= lr; i++) {
-            pr[i] = p1[i] * s;
+            pr.c[i] = p1.at(i) * s;
         }
+        pr.normalize();
     }
 
     // pr = p1 / s; O(l1)
@@ -233,8 +469,9 @@ public:
         int lr = p1.deg();
         pr.resize(lr + 1, p1.ZERO_COEFF);
         for (int i = 0; i <= lr; i++) {
-            pr[i] = p1[i] / s;
+            pr.c[i] = p1.at(i) / s;
         }
+        pr.normalize();
     }
 
     bool operator == (const polynom &rhs) const { return cmp(*this, rhs) == 0; }
@@ -325,6 +562,122 @@ struct polynom_mul {
     }
 };
 
+/**
+ * `polynom<T>` operand prepared for repeated multiplication.
+ *
+ * Specializations keep the operand in the transform domain, so that each
+ * multiplication only transforms the other factor. This generic version
+ * just keeps the operand and multiplies as usual.
+ */
+template<typename T>
+class polynom_operand {
+public:
+    polynom<T> p;
+
+    // prepares `p` for multiplication by polynomials of degree up to `l1`;
+    // if -1, the degree of `p` is assumed
+    explicit polynom_operand(const polynom<T> &p, int l1 = -1) : p(p) {}
+
+    // pr = p1 * p; see `polynom<T>::mul`
+    void mul(polynom<T> &pr, const polynom<T> &p1, int lr = -1) const {
+        polynom<T>::mul(pr, p1, p, lr);
+    }
+
+    // pr = (p1 * p)[lo, hr]; see `polynom<T>::mul_middle`
+    void mul_middle(polynom<T> &pr, const polynom<T> &p1, int lo, int hr) const {
+        polynom<T>::mul_middle(pr, p1, p, lo, hr);
+    }
+};
+
+/**
+ * `polynom<T>` divisor prepared for repeated division.
+ *
+ * Above `polynom<T>::newton_div_threshold`, the inverse of the reversed divisor
+ * and the divisor itself are kept as prepared operands, so that each division
+ * takes just the two multiplications of `polynom<T>::_quot_rem_newton`.
+ * Dividends of a higher degree than prepared for are divided as usual.
+ */
+template<typename T>
+class polynom_divisor {
+    static polynom<T> reversed_inverse(const polynom<T> &p, int lm, int lr) {
+        polynom<T> pi(p.ZERO_COEFF);
+        pi.c.assign(p.c.rend() - lm - 1, p.c.rend() - std::max(lm - lr, 0));
+        polynom<T>::inverse(pi, pi, lr + 1);
+        return pi;
+    }
+
+public:
+    polynom<T> p;
+    int lm;                     // the degree of `p`
+    int l1;                     // the degree of the dividends prepared for
+    bool newton;                // whether `pi` and `po` are prepared
+    polynom_operand<T> pi;      // 1 / rev(p) (mod x^(l1 - lm + 1))
+    polynom_operand<T> po;      // p
+
+    // prepares `p` for division of polynomials of degree up to `l1`;
+    // if -1, `2 * deg(p) - 2` is assumed, the degree of a product of two remainders
+    explicit polynom_divisor(const polynom<T> &p, int l1 = -1) :
+        p(p),
+        lm(p.deg()),
+        l1((l1 < 0) ? std::max(lm * 2 - 2, lm) : l1),
+        newton(std::min(this->l1 - lm, lm) >= polynom<T>::newton_div_threshold() && !p.is_power()),
+        pi(newton ? reversed_inverse(p, lm, this->l1 - lm) : polynom<T>(p.ZERO_COEFF), newton ? this->l1 - lm : 0),
+        po(newton ? p : polynom<T>(p.ZERO_COEFF), newton ? std::min(this->l1 - lm, lm - 1) : 0) {}
+
+    // pr = p1 % p | p1 / p; see `polynom<T>::quot_rem`
+    // it is allowed for `p1` and `pr` to be the same instance
+    void quot_rem(polynom<T> &pr, const polynom<T> &p1) const {
+        int k1 = p1.deg(), lr = k1 - lm;
+        if (newton && k1 <= l1 && std::min(lr, lm) >= polynom<T>::newton_div_threshold()) {
+            polynom<T>::_quot_rem_newton(pr, p1, k1, pi, po, lm);
+        } else {
+            polynom<T>::quot_rem(pr, p1, p);
+        }
+    }
+};
+
+/**
+ * Modulo multiplication context for a polynomial modulus
+ *
+ * Reduces each product by the modulus prepared once; see `polynom_divisor`.
+ */
+template<typename T>
+struct modulo_reducer<polynom<T>> {
+    polynom_divisor<T> d;
+    explicit modulo_reducer(const polynom<T>& M = polynom<T>()) : d(M) {}
+    bool is_for(const polynom<T>& M) const { return d.p == M; }
+    polynom<T> mul(const polynom<T>& x, const polynom<T>& y, const polynom<T>& M) const {
+        polynom<T> r(M.ZERO_COEFF);
+        polynom<T>::mul(r, x, y);
+        if (is_for(M)) {
+            polynom<T>::mod(r, r, d);
+        } else {
+            polynom<T>::mod(r, r, M);
+        }
+        return r;
+    }
+};
+
+/**
+ * `polynom<T>` middle product implementation.
+ *
+ * Specialize this template for a transform based implementation.
+ * You may call the already provided `polynom<T>::_mul_middle`.
+ * Only the coefficients in the range [lo, hr] are needed, so a cyclic
+ * convolution of any size greater than both `hr` and `l1 + l2 - lo` will do,
+ * as the wrapped around coefficients all land below `lo`.
+ */
+template<typename T>
+struct polynom_mul_middle {
+    // @param pr - The result: `pr[i - lo] = (p1 * p2)[i]`, for `lo <= i <= hr`.
+    //             It is not allowed to be the same instance as `p1` or `p2`.
+    // @param lX - The lengths of the polynomials: `0 <= lo <= hr <= l1 + l2`
+    //             and `l1, l2 <= hr`.
+    static void impl(T* pr, int lo, int hr, const T* p1, int l1, const T* p2, int l2) {
+        polynom<T>::_mul_middle(pr, lo, hr, p1, l1, p2, l2);
+    }
+};
+
 template<typename T, typename I>
 struct castT<polynom<T>, I> {
     static polynom<T> of(const I& x) {
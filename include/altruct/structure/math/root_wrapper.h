@@ -40,16 +40,20 @@ struct identityT<root_wrapper<T>> {
 
 /**
  * Returns a root_wrapper<cplx> of principal k-th root
- * of unity for some power of 2 `k` no smaller than `l`.
+ * of unity for the smallest power of 2 `k` no smaller than `l`.
+ * The roots are cached per `k`, so the result does not depend on earlier calls.
  */
 template<typename F>
 root_wrapper<complex<F>> complex_root_wrapper(int l) {
     typedef complex<F> cplx;
     static const auto _2_PI = 2 * acos(F(-1));
-    static std::vector<cplx> roots{F(1)};
-    int size = (int)roots.size();
-    if (size < l) {
-        while (size < l) size *= 2;
+    static std::vector<std::vector<cplx>> tables;
+    int k = 0;
+    while ((1 << k) < l) k++;
+    if ((int)tables.size() <= k) tables.resize(k + 1);
+    auto& roots = tables[k];
+    int size = 1 << k;
+    if (roots.empty()) {
         roots.resize(size);
         for (int i = 0; i < size; i++) {
             auto A = _2_PI * i / size;
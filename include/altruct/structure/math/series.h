@@ -2,6 +2,8 @@
 
 #include "altruct/structure/math/polynom.h"
 
+#include <stdexcept>
+
 namespace altruct {
 namespace math {
 
@@ -95,13 +97,14 @@ public:
     series  operator *  (const T &val) const { series t(*this); t *= val; return t; }
     series  operator /  (const T &val) const { series t(*this); t /= val; return t; }
 
-    series& operator += (const series &rhs) { p += rhs.p; return *this; }
-    series& operator -= (const series &rhs) { p -= rhs.p; return *this; }
+    // polynom arithmetic trims the result, so `p` is extended back to `N` coefficients
+    series& operator += (const series &rhs) { p += rhs.p; p.reserve(this->N()); return *this; }
+    series& operator -= (const series &rhs) { p -= rhs.p; p.reserve(this->N()); return *this; }
     series& operator *= (const series& rhs) { polynom<T>::mul(p, p, rhs.p, this->N() - 1); return *this; }
     series& operator /= (const series& rhs) { return *this *= rhs.inverse(); }
 
-    series& operator *= (const T &val) { p *= val; return *this; }
-    series& operator /= (const T &val) { p /= val; return *this; }
+    series& operator *= (const T &val) { p *= val; p.reserve(this->N()); return *this; }
+    series& operator /= (const T &val) { p /= val; p.reserve(this->N()); return *this; }
 
     series derivative() const { return series(p.derivative(), this->N()); }
     series integral() const { return integral(p.ZERO_COEFF); }
@@ -109,15 +112,12 @@ public:
 
     // s(x)*x^l - shifts coefficients of s(x) by l places
     series shift(int l) const {
-        if (l < 0) {
-            polynom<T> t{ p.c.begin() - l, p.c.end() };
-            t.c.insert(t.c.end(), -l, p.ZERO_COEFF);
-            return series(t, this->N());
-        } else {
-            polynom<T> t{ p.c.begin(), p.c.end() - l };
-            t.c.insert(t.c.begin(), l, p.ZERO_COEFF);
-            return series(t, this->N());
+        polynom<T> t(p.ZERO_COEFF);
+        t.resize(this->N());
+        for (int i = std::max(l, 0); i < this->N(); i++) {
+            t[i] = p.at(i - l);
         }
+        return series(std::move(t), this->N());
     }
 
     // s(x*a)
@@ -147,17 +147,8 @@ public:
         // ensure that p[0] is 1 before inverting
         if (p[0] == zeroT<T>::of(p[0])) return series(polynom<T>{ p.ZERO_COEFF }, this->N());
         if (p[0] != identityT<T>::of(p[0])) return (*this / p[0]).inverse() / p[0];
-        polynom<T> r{id_coeff()}, t;
-        for (int l = 1; l < this->N() * 2; l *= 2) {
-            int m = std::min(this->N() - 1, l), k = l / 2 + 1;
-            t.c.assign(p.c.begin(), p.c.begin() + m + 1);
-            polynom<T>::mul(t, t, r, l + 1);
-            t.c.erase(t.c.begin(), t.c.begin() + k);
-            polynom<T>::mul(t, t, r, l - k);
-            for (int i = m; i >= k; i--) {
-                r[i] = -t[i - k];
-            }
-        }
+        polynom<T> r;
+        polynom<T>::inverse(r, p, this->N());
         return series(std::move(r), this->N());
     }
 
@@ -165,15 +156,36 @@ public:
     // the following should hold: s(0) == 0
     series exp() const {
         // See R.P.Brent & H.T.Kung - Fast Algorithms for Manipulating Formal Power Series
-        typedef series<T, 0, series_storage::INSTANCE> serx;
-        polynom<T> r{ id_coeff() }, t;
+        // and G.Hanrot & P.Zimmermann - Newton Iteration Revisited
+        // `g = 1 / r (mod x^l)` is maintained along with `r = exp(s) (mod x^l)`
+        polynom<T> r{ id_coeff() }, g{ id_coeff() }, q = p.derivative(), t(p.ZERO_COEFF), e(p.ZERO_COEFF);
         for (int l = 1; l < this->N(); l *= 2) {
+            // ln(r) = s + O(x^l), hence exp(s) = r * (1 + s - ln(r)) = r + r * t * x^l + O(x^2l),
+            // where `t * x^l` is `s - ln(r)`; since `r' / r = s' + (r' - r * s') / r`
+            // and `r' - r * s'` vanishes below `x^(l-1)`, only `g` is needed for the division;
+            // moreover `r'` vanishes above `x^(l-2)`, hence `t = Integral[(r * s')[l-1, m-2] * g]`
             int m = std::min(this->N(), l * 2);
-            t.c.assign(p.c.begin(), p.c.begin() + m);
-            t -= serx(r, m).ln().p;
-            t[0] += id_coeff();
-            polynom<T>::mul(r, r, t, m - 1);
+            polynom_operand<T> go(g, l - 1);
+            polynom<T>::mul_middle(t, r, q, l - 1, m - 2);
+            polynom<T>::mul(t, t, go, m - l - 1);
+            for (int i = l; i < m; i++) {
+                t[i - l] /= i;
+            }
+            polynom<T>::mul(t, t, r, m - l - 1);
+            r.resize(m);
+            for (int i = l; i < m; i++) {
+                r[i] = t[i - l];
+            }
+            if (m == this->N()) break;
+            // r * g = 1 + e * x^l + O(x^2l), hence 1/r = g - e * g * x^l + O(x^2l)
+            polynom<T>::mul_middle(e, r, go, l, m - 1);
+            polynom<T>::mul(e, e, go, m - l - 1);
+            g.resize(m);
+            for (int i = l; i < m; i++) {
+                g[i] = -e[i - l];
+            }
         }
+        r.resize(this->N());
         return series(std::move(r), this->N());
     }
 
@@ -181,7 +193,65 @@ public:
     // the following should hold: s(0) == 1
     series ln() const { return ln(p.ZERO_COEFF); }
     series ln(const T& c0) const {
-        return (derivative() / *this).integral(c0);
+        if (this->N() <= 1) return series(polynom<T>{ c0 }, this->N());
+        polynom<T> r;
+        polynom<T>::divide(r, p.derivative(), p, this->N() - 1);
+        return series(std::move(r), this->N()).integral(c0);
+    }
+
+    // sqrt(s(x)) - series expansion of the square root of s(x)
+    // the following should hold: s(0) == c0^2, and 2 must be invertible;
+    // without `c0`, the lowest nonzero coefficient of s(x) must be 1 and of even order `l`,
+    // otherwise `std::domain_error` is thrown; the top l/2 coefficients of the result
+    // depend on the coefficients of s(x) beyond N, and are set to zero
+    series sqrt() const {
+        if (p[0] == p.ZERO_COEFF) {
+            int l = p.lowest();
+            if (l == 0) return *this; // s(x) == 0
+            if (l % 2 != 0) throw std::domain_error("series sqrt of an odd order");
+            series r = shift(-l).sqrt().shift(l / 2);
+            for (int i = this->N() - l / 2; i < this->N(); i++) r[i] = p.ZERO_COEFF;
+            return r;
+        }
+        return sqrt(id_coeff());
+    }
+    series sqrt(const T& c0) const { return sqrt_impl(c0, false); }
+
+    // 1/sqrt(s(x)) - series expansion of the inverse square root of s(x)
+    // the following should hold: s(0) == 1 / c0^2, and 2 must be invertible
+    series inverse_sqrt() const { return inverse_sqrt(id_coeff()); }
+    series inverse_sqrt(const T& c0) const { return sqrt_impl(id_coeff() / c0, true); }
+
+    // sqrt(s(x)) or 1/sqrt(s(x)), where `c0 = sqrt(s(0))`
+    series sqrt_impl(const T& c0, bool inverse) const {
+        // Newton iteration for r^2 = s along with `g = 1 / r (mod x^l)`
+        // r^2 = s + e * x^l + O(x^2l), hence sqrt(s) = r - e * g / 2 * x^l + O(x^2l)
+        polynom<T> r{ c0 }, g{ id_coeff() / c0 }, e(p.ZERO_COEFF);
+        T inv2 = id_coeff() / castOf(p.ZERO_COEFF, 2);
+        for (int l = 1; l < this->N(); l *= 2) {
+            int m = std::min(this->N(), l * 2);
+            polynom_operand<T> go(g, l - 1);
+            polynom<T>::mul_middle(e, r, r, l, m - 1);
+            for (int i = l; i < m; i++) {
+                e[i - l] = (p[i] - e[i - l]) * inv2;
+            }
+            polynom<T>::mul(e, e, go, m - l - 1);
+            r.resize(m);
+            for (int i = l; i < m; i++) {
+                r[i] = e[i - l];
+            }
+            if (m == this->N() && !inverse) break;
+            // r * g = 1 + e * x^l + O(x^2l), hence 1/r = g - e * g * x^l + O(x^2l)
+            polynom<T>::mul_middle(e, r, go, l, m - 1);
+            polynom<T>::mul(e, e, go, m - l - 1);
+            g.resize(m);
+            for (int i = l; i < m; i++) {
+                g[i] = -e[i - l];
+            }
+        }
+        if (inverse) r.swap(g);
+        r.resize(this->N());
+        return series(std::move(r), this->N());
     }
 
     // s(x)^a - a-th power of s(x)
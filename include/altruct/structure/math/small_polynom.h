@@ -0,0 +1,203 @@
+#pragma once
+
+#include "altruct/algorithm/math/base.h"
+#include "altruct/structure/math/polynom.h"
+
+#include <array>
+#include <initializer_list>
+
+namespace altruct {
+namespace math {
+
+/**
+ * Polynomial with coefficients in T, of degree less than N, with inline storage.
+ *
+ * Intended for the many tiny polynomials of matrix-of-polynomial and recurrence
+ * code, where the heap allocation of `polynom<T>` dominates. The arithmetic is
+ * done modulo `x^N`, the same as of fixed-width integers modulo `2^w`, and all the
+ * loops over the coefficients have a compile time trip count, so the compiler can
+ * unroll them. So `N` has to exceed the degree of any product needed exactly.
+ *
+ * As an exception, the product in `moduloX<small_polynom<T, N>>` is computed in
+ * full and then reduced, so that `N` only needs to exceed the degree of the
+ * modulus. E.g. `x^n mod p(x)`, for `p` of degree `L < N`:
+ *
+ *   typedef moduloX<small_polynom<T, N>> polymod;
+ *   powT(polymod(small_polynom<T, N>{ 0, 1 }, p), n).v;
+ *
+ * There is no separate zero coefficient; it is taken from `c[0]`.
+ */
+template<typename T, int N>
+class small_polynom {
+public:
+    static_assert(N >= 1, "small_polynom must have at least one coefficient");
+
+    // p(x) = sum{c[i] * x^i}
+    std::array<T, N> c;
+
+    small_polynom(const T& c0 = T(0)) { c.fill(zeroOf(c0)); c[0] = c0; }
+    // construct from int, but only if T is not integral to avoid constructor clashing
+    template <typename I = T, typename = std::enable_if_t<!std::is_integral<I>::value>>
+    small_polynom(int c0) { c.fill(zeroOf(T(c0))); c[0] = c0; } // to allow constructing from 0 and 1
+    template<typename It> small_polynom(It begin, It end) { assign(begin, end); }
+    small_polynom(std::initializer_list<T> list) { assign(list.begin(), list.end()); }
+    explicit small_polynom(const polynom<T>& p) { assign(p.c.begin(), p.c.end()); }
+
+    // the first `N` coefficients from the range; the rest is zero
+    template<typename It>
+    void assign(It begin, It end) {
+        c.fill((begin != end) ? zeroOf(T(*begin)) : T(0));
+        for (int i = 0; i < N && begin != end; i++, ++begin) c[i] = *begin;
+    }
+
+    polynom<T> to_polynom() const { return polynom<T>(c.begin(), c.begin() + deg() + 1); }
+
+    int size() const { return N; }
+    const T& operator [] (int index) const { return c[index]; }
+    T& operator [] (int index) { return c[index]; }
+    int deg() const { T e0 = zeroOf(c[0]); for (int i = N - 1; i > 0; i--) if (!(c[i] == e0)) return i; return 0; }
+    const T& leading_coeff() const { return c[deg()]; }
+
+    int cmp(const small_polynom& rhs) const {
+        for (int i = N - 1; i >= 0; i--) {
+            if (c[i] < rhs.c[i]) return -1;
+            if (rhs.c[i] < c[i]) return +1;
+        }
+        return 0;
+    }
+
+    // pr[0 : 2N-2] = p1 * p2; the full product
+    static void _mul_full(T* pr, const small_polynom& p1, const small_polynom& p2) {
+        T e0 = zeroOf(p1.c[0]);
+        for (int k = 0; k < N * 2 - 1; k++) pr[k] = e0;
+        for (int i = 0; i < N; i++) {
+            for (int j = 0; j < N; j++) {
+                pr[i + j] += p1.c[i] * p2.c[j];
+            }
+        }
+    }
+
+    // p[0 : l] = p[0 : l] % pm, and the quotient in `p[lm : l]`; where `lm` is the degree of `pm`
+    // `pm` must be nonzero, and its leading coefficient invertible
+    static void _quot_rem(T* p, int l, const small_polynom& pm) {
+        int lm = pm.deg();
+        T e0 = zeroOf(pm.c[0]), e1 = identityOf(e0);
+        bool monic = pm.c[lm] == e1;
+        for (int i = l; i >= lm; i--) {
+            if (!monic) p[i] /= pm.c[lm];
+            T s = p[i]; if (s == e0) continue;
+            for (int j = 1; j <= lm; j++) {
+                p[i - j] -= s * pm.c[lm - j];
+            }
+        }
+    }
+
+    // pr = p1 * p2 % pm; unlike `*`, not truncated to `N` coefficients before the reduction
+    static small_polynom mul_mod(const small_polynom& p1, const small_polynom& p2, const small_polynom& pm) {
+        std::array<T, N * 2 - 1> w;
+        _mul_full(w.data(), p1, p2);
+        _quot_rem(w.data(), N * 2 - 2, pm);
+        small_polynom r(zeroOf(p1.c[0]));
+        int lm = pm.deg();
+        for (int i = 0; i < lm; i++) r.c[i] = w[i];
+        return r;
+    }
+
+    bool operator == (const small_polynom& rhs) const { return cmp(rhs) == 0; }
+    bool operator != (const small_polynom& rhs) const { return cmp(rhs) != 0; }
+    bool operator <  (const small_polynom& rhs) const { return cmp(rhs) <  0; }
+    bool operator >  (const small_polynom& rhs) const { return cmp(rhs) >  0; }
+    bool operator <= (const small_polynom& rhs) const { return cmp(rhs) <= 0; }
+    bool operator >= (const small_polynom& rhs) const { return cmp(rhs) >= 0; }
+
+    small_polynom  operator +  (const small_polynom& rhs) const { small_polynom t(*this); t += rhs; return t; }
+    small_polynom  operator -  (const small_polynom& rhs) const { small_polynom t(*this); t -= rhs; return t; }
+    small_polynom  operator -  ()                         const { small_polynom t(*this); for (int i = 0; i < N; i++) t.c[i] = -c[i]; return t; }
+    small_polynom  operator *  (const small_polynom& rhs) const { small_polynom t(*this); t *= rhs; return t; }
+    small_polynom  operator /  (const small_polynom& rhs) const { small_polynom t(*this); t /= rhs; return t; }
+    small_polynom  operator %  (const small_polynom& rhs) const { small_polynom t(*this); t %= rhs; return t; }
+
+    small_polynom  operator *  (const T& val) const { small_polynom t(*this); t *= val; return t; }
+    small_polynom  operator /  (const T& val) const { small_polynom t(*this); t /= val; return t; }
+
+    small_polynom& operator += (const small_polynom& rhs) { for (int i = 0; i < N; i++) c[i] += rhs.c[i]; return *this; }
+    small_polynom& operator -= (const small_polynom& rhs) { for (int i = 0; i < N; i++) c[i] -= rhs.c[i]; return *this; }
+    // modulo `x^N`
+    small_polynom& operator *= (const small_polynom& rhs) {
+        small_polynom t(zeroOf(c[0]));
+        for (int i = 0; i < N; i++) {
+            for (int j = 0; i + j < N; j++) {
+                t.c[i + j] += c[i] * rhs.c[j];
+            }
+        }
+        return *this = t;
+    }
+    small_polynom& operator /= (const small_polynom& rhs) {
+        int l = deg(), lm = rhs.deg();
+        if (l < lm) return *this = small_polynom(zeroOf(c[0]));
+        _quot_rem(c.data(), l, rhs);
+        small_polynom q(zeroOf(c[0]));
+        for (int i = 0; i <= l - lm; i++) q.c[i] = c[lm + i];
+        return *this = q;
+    }
+    small_polynom& operator %= (const small_polynom& rhs) {
+        int l = deg(), lm = rhs.deg();
+        if (l < lm) return *this;
+        _quot_rem(c.data(), l, rhs);
+        T e0 = zeroOf(c[0]);
+        for (int i = lm; i <= l; i++) c[i] = e0;
+        return *this;
+    }
+
+    small_polynom& operator *= (const T& val) { for (int i = 0; i < N; i++) c[i] *= val; return *this; }
+    small_polynom& operator /= (const T& val) { for (int i = 0; i < N; i++) c[i] /= val; return *this; }
+
+    template<typename A>
+    A operator () (const A& x) const { return eval<A>(x); }
+
+    template<typename A>
+    A eval(const A& x) const {
+        A r = zeroOf(x);
+        for (int i = N - 1; i >= 0; i--) {
+            r = r * x + castOf(x, c[i]);
+        }
+        return r;
+    }
+};
+
+/**
+ * `moduloX<small_polynom<T, N>>` multiplication; see `small_polynom::mul_mod`
+ */
+template<typename T, int N>
+small_polynom<T, N> modulo_mul(const small_polynom<T, N>& x, const small_polynom<T, N>& y, const small_polynom<T, N>& M) {
+    return small_polynom<T, N>::mul_mod(x, y, M);
+}
+
+template<typename T, int N, typename I>
+struct castT<small_polynom<T, N>, I> {
+    static small_polynom<T, N> of(const I& x) {
+        return small_polynom<T, N>(castOf<T>(x));
+    }
+    static small_polynom<T, N> of(const small_polynom<T, N>& ref, const I& x) {
+        return small_polynom<T, N>(castOf(ref.c[0], x));
+    }
+};
+template<typename T, int N>
+struct castT<small_polynom<T, N>, small_polynom<T, N>> : nopCastT<small_polynom<T, N>>{};
+
+template<typename T, int N>
+struct identityT<small_polynom<T, N>> {
+    static small_polynom<T, N> of(const small_polynom<T, N>& p) {
+        return small_polynom<T, N>(identityOf(p.c[0]));
+    }
+};
+
+template<typename T, int N>
+struct zeroT<small_polynom<T, N>> {
+    static small_polynom<T, N> of(const small_polynom<T, N>& p) {
+        return small_polynom<T, N>(zeroOf(p.c[0]));
+    }
+};
+
+} // math
+} // altruct
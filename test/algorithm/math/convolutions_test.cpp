@@ -2,6 +2,8 @@
 #include "altruct/structure/math/modulo.h"
 
 #include <algorithm>
+#include <ctime>
+#include <iostream>
 #include <vector>
 
 #include "gtest/gtest.h"
@@ -85,6 +87,141 @@ TEST(convolutions_test, xor_convolution) {
     EXPECT_EQ(z0, z1);
 }
 
+TEST(convolutions_test, subset_convolution) {
+    typedef modulo<int, 1000000007, modulo_storage::CONSTANT> mod;
+    for (int L = 0; L <= 8; L++) {
+        const int n = 1 << L;
+        vector<mod> u(n), v(n);
+        for (int i = 0; i < n; i++) u[i] = mod(i * 12345 + 678), v[i] = mod(i * 54321 + 876);
+        vector<mod> r0(n), r1(n);
+        slow_subset_convolution(r0.data(), u.data(), v.data(), L);
+        subset_convolution(r1.data(), u.data(), v.data(), L);
+        EXPECT_EQ(r0, r1) << "L=" << L;
+        // inplace
+        vector<mod> z0(n), z1 = u;
+        slow_subset_convolution(z0.data(), u.data(), u.data(), L);
+        subset_convolution(z1.data(), z1.data(), z1.data(), L);
+        EXPECT_EQ(z0, z1) << "L=" << L;
+    }
+    // on several threads, as done for the arrays larger than the block
+    int block_bytes = fast_radix2_block_bytes();
+    int num_threads = altruct::concurrency::default_num_threads();
+    fast_radix2_block_bytes() = 64;
+    altruct::concurrency::default_num_threads() = 3;
+    for (int L = 0; L <= 8; L++) {
+        const int n = 1 << L;
+        vector<mod> u(n), v(n);
+        for (int i = 0; i < n; i++) u[i] = mod(i * 12345 + 678), v[i] = mod(i * 54321 + 876);
+        vector<mod> r0(n), r1(n);
+        slow_subset_convolution(r0.data(), u.data(), v.data(), L);
+        subset_convolution(r1.data(), u.data(), v.data(), L);
+        EXPECT_EQ(r0, r1) << "L=" << L;
+    }
+    altruct::concurrency::default_num_threads() = num_threads;
+    fast_radix2_block_bytes() = block_bytes;
+    // counts the partitions of a 3 element set into two labeled nonempty parts
+    vector<int> f{ 0, 1, 1, 1, 1, 1, 1, 1 }, r(8);
+    subset_convolution(r.data(), f.data(), f.data(), 3);
+    EXPECT_EQ((vector<int>{ 0, 0, 0, 2, 0, 2, 2, 6 }), r);
+}
+
+TEST(convolutions_test, blocked) {
+    typedef modulo<int, 1000000007, modulo_storage::CONSTANT> mod;
+    int block_bytes = fast_radix2_block_bytes();
+    int num_threads = altruct::concurrency::default_num_threads();
+    bool enabled = simd_enabled();
+    for (int L = 0; L <= 12; L++) {
+        const int n = 1 << L;
+        vector<mod> u(n);
+        for (int i = 0; i < n; i++) u[i] = mod(i * 12345 + 678);
+        vector<mod> e0 = u, e1 = u;
+        fast_walsh_hadamard_transform(e0.data(), L);
+        fast_arith_transform_plus(e1.data(), L);
+        for (int t : { 1, 3 }) {
+            altruct::concurrency::default_num_threads() = t;
+            for (int b : { 4, 64, 1024 }) {
+                fast_radix2_block_bytes() = b;
+                for (bool simd : { false, true }) {
+                    simd_enabled() = simd && enabled;
+                    vector<mod> r0 = u, r1 = u;
+                    fast_walsh_hadamard_transform(r0.data(), L);
+                    fast_arith_transform_plus(r1.data(), L);
+                    EXPECT_EQ(e0, r0) << "L=" << L << " t=" << t << " b=" << b << " simd=" << simd;
+                    EXPECT_EQ(e1, r1) << "L=" << L << " t=" << t << " b=" << b << " simd=" << simd;
+                    fast_arith_transform_minus(r1.data(), L);
+                    EXPECT_EQ(u, r1) << "L=" << L << " t=" << t << " b=" << b << " simd=" << simd;
+                }
+            }
+        }
+    }
+    simd_enabled() = enabled;
+    altruct::concurrency::default_num_threads() = num_threads;
+    fast_radix2_block_bytes() = block_bytes;
+}
+
+TEST(convolutions_test, simd) {
+    typedef modulo<int, 1000000007, modulo_storage::CONSTANT> mod;
+    typedef modulo<int, 1, modulo_storage::STATIC> modr;
+    modr::M() = 1000000009;
+    bool enabled = simd_enabled();
+    for (int L = 0; L <= 10; L++) {
+        const int n = 1 << L;
+        vector<mod> u(n), v(n);
+        vector<modr> ur(n), vr(n);
+        for (int i = 0; i < n; i++) {
+            u[i] = mod(i * 12345 + 678), v[i] = mod(i * 54321 + 876);
+            ur[i] = modr(-i * 12345 - 678), vr[i] = modr(-i * 54321 - 876);
+        }
+        auto test = [&](void(*conv)(mod*, mod*, mod*, int), void(*convr)(modr*, modr*, modr*, int)) {
+            vector<mod> u0 = u, v0 = v, u1 = u, v1 = v, r0(n), r1(n);
+            vector<modr> ur0 = ur, vr0 = vr, ur1 = ur, vr1 = vr, rr0(n), rr1(n);
+            simd_enabled() = false;
+            conv(r0.data(), u0.data(), v0.data(), L);
+            convr(rr0.data(), ur0.data(), vr0.data(), L);
+            simd_enabled() = enabled;
+            conv(r1.data(), u1.data(), v1.data(), L);
+            convr(rr1.data(), ur1.data(), vr1.data(), L);
+            EXPECT_EQ(r0, r1) << "L=" << L;
+            EXPECT_EQ(rr0, rr1) << "L=" << L;
+        };
+        test(and_convolution<mod>, and_convolution<modr>);
+        test(or_convolution<mod>, or_convolution<modr>);
+        test(xor_convolution<mod>, xor_convolution<modr>);
+        if (L <= 6) {
+            vector<mod> u0 = u, v0 = v, r0(n), r1(n);
+            slow_xor_convolution(r0.data(), u.data(), v.data(), L);
+            xor_convolution(r1.data(), u0.data(), v0.data(), L);
+            EXPECT_EQ(r0, r1) << "L=" << L;
+        }
+    }
+}
+
+TEST(convolutions_test, perf) {
+    return; // skip perf tests
+
+    typedef modulo<int, 1000000007, modulo_storage::CONSTANT> mod;
+    const int L = 22, n = 1 << L;
+    vector<mod> f(n);
+    for (int i = 0; i < n; i++) f[i] = mod(i * 12345 + 678);
+    bool enabled = simd_enabled();
+    for (bool simd : { false, true }) {
+        simd_enabled() = simd && enabled;
+        auto T0 = clock();
+        for (int i = 0; i < 10; i++) fast_walsh_hadamard_transform(f.data(), L);
+        auto T1 = clock();
+        for (int i = 0; i < 10; i++) fast_arith_transform_plus(f.data(), L), fast_arith_transform_minus(f.data(), L);
+        auto T2 = clock();
+        cout << (simd_enabled() ? "simd" : "scalar") << " walsh_hadamard: " << T1 - T0 << " ms; arith_plus + arith_minus: " << T2 - T1 << " ms" << endl;
+    }
+    simd_enabled() = enabled;
+    const int LS = 20, ns = 1 << LS;
+    vector<mod> fs(ns), rs(ns);
+    for (int i = 0; i < ns; i++) fs[i] = mod(i * 12345 + 678);
+    auto T3 = clock();
+    subset_convolution(rs.data(), fs.data(), fs.data(), LS);
+    cout << "subset_convolution: " << clock() - T3 << " ms" << endl;
+}
+
 TEST(convolutions_test, cyclic_convolution) {
     typedef modulo<int, 12289> mod;
     const int n = 16;
@@ -1,5 +1,7 @@
 ﻿#include "altruct/algorithm/math/fft.h"
+#include "altruct/structure/math/complex.h"
 #include "altruct/structure/math/modulo.h"
+#include "altruct/structure/math/root_wrapper.h"
 
 #include <algorithm>
 #include <vector>
@@ -66,6 +68,26 @@ TEST(fft_test, fft_inverse) {
     EXPECT_EQ((vector<mod>{ 671, 9230, 3302, 4764, 6135, 7750, 9881, 1189, 411, 8144, 0, 0, 0, 0, 0, 0 }), vector<mod>(a, a + n));
 }
 
+TEST(fft_test, fft_unpack_real) {
+    typedef complex<double> cplx;
+    const int n = 16;
+    auto root = complex_root_wrapper<double>(n);
+    root = powT(root, root.size / n);
+    double x[n] = { 671, 9230, 3302, 4764, 6135, 7750, 9881, 1189, 411, 8144 };
+    double y[n] = { 8468, 3944, 4798, 6405, 8016, 8884, 1006, 54, 7066, 3531, 1, 2, 3 };
+    cplx xs[n], ys[n], zs[n], X[n], Y[n], Z[n];
+    for (int i = 0; i < n; i++) xs[i] = cplx(x[i]), ys[i] = cplx(y[i]), zs[i] = cplx(x[i], y[i]);
+    fft_rec(X, xs, n, root);
+    fft_rec(Y, ys, n, root);
+    fft_rec(Z, zs, n, root);
+    for (int k = 0; k < n; k++) {
+        cplx xk, yk;
+        fft_unpack_real(Z[k], Z[(n - k) % n], &xk, &yk);
+        EXPECT_NEAR(X[k].a, xk.a, 1e-9); EXPECT_NEAR(X[k].b, xk.b, 1e-9);
+        EXPECT_NEAR(Y[k].a, yk.a, 1e-9); EXPECT_NEAR(Y[k].b, yk.b, 1e-9);
+    }
+}
+
 TEST(fft_test, fft_cyclic_convolution) {
     const int n = 16;
     mod u[n] = { 671, 9230, 3302, 4764, 6135, 7750, 9881, 1189, 411, 8144 };
@@ -141,3 +163,45 @@ TEST(fft_test, convolutions) {
     test_convolutions({ 671 }, { 8468, 3944, 4798, 6405, 8016, 8884, 1006, 54, 7066, 3531, 12, 3407, 551 });
     test_convolutions({ 8468, 3944, 4798, 6405, 8016, 8884, 1006, 54, 7066, 3531, 12, 3407, 551 }, { 671 });
 }
+
+TEST(fft_test, cyclic_convolution_coprime_sizes) {
+    vector<mod> u, v;
+    for (int i = 0; i < 37; i++) u.push_back(mod(i * i + 5));
+    for (int i = 0; i < 29; i++) v.push_back(mod(i * 7 + 3));
+    test_cyclic_convolution(u, v);
+    test_cyclic_convolution(v, u);
+}
+
+TEST(fft_test, chirp_z) {
+    // DFT of length 12, the order of 11^1024 modulo 12289
+    const int n = 12;
+    mod z = powT(mod(11), 12288 / n);
+    vector<mod> a{ 671, 9230, 3302, 4764, 6135, 7750, 9881, 1189, 411, 8144, 12, 3407 }, e(n), r(n), b(n);
+    for (int k = 0; k < n; k++) for (int j = 0; j < n; j++) e[k] += a[j] * powT(z, j * k);
+    chirp_z(r.data(), n, a.data(), n, z, mod(41), 1 << 12);
+    EXPECT_EQ(e, r);
+    chirp_z(b.data(), n, r.data(), n, mod(1) / z, mod(41), 1 << 12);
+    for (auto& x : b) x /= n;
+    EXPECT_EQ(a, b);
+    // evaluation at a geometric progression
+    vector<mod> p{ 8468, 3944, 4798, 6405, 8016, 8884, 1006 }, ep(20), rp(20);
+    for (int k = 0; k < 20; k++) for (int j = 0; j < 7; j++) ep[k] += p[j] * powT(mod(5), j * k);
+    chirp_z(rp.data(), 20, p.data(), 7, mod(5), mod(41), 1 << 12);
+    EXPECT_EQ(ep, rp);
+}
+
+TEST(fft_test, chirp_z_complex) {
+    typedef complex<double> cplx;
+    const int n = 10;
+    auto root = complex_root_wrapper<double>(32);
+    double t = 2 * acos(-1.0) / n;
+    cplx z(cos(t), sin(t));
+    vector<cplx> a(n), r(n);
+    for (int j = 0; j < n; j++) a[j] = cplx(j * j + 1, 3 - j);
+    chirp_z(r.data(), n, a.data(), n, z, root, root.size);
+    for (int k = 0; k < n; k++) {
+        cplx e;
+        for (int j = 0; j < n; j++) e += a[j] * cplx(cos(t * j * k), sin(t * j * k));
+        EXPECT_NEAR(e.a, r[k].a, 1e-9); EXPECT_NEAR(e.b, r[k].b, 1e-9);
+    }
+}
@@ -0,0 +1,107 @@
+﻿#include "altruct/algorithm/math/matrix_mod.h"
+#include "altruct/concurrency/parallel.h"
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+using namespace std;
+using namespace altruct::math;
+
+namespace {
+typedef modulo<int, 1000000007, modulo_storage::CONSTANT> mod;
+typedef modulo<int, 1073741789, modulo_storage::CONSTANT> modb;
+typedef modulo<int, 3, modulo_storage::CONSTANT> mod3;
+typedef modulo<int, 1000000007, modulo_storage::STATIC> mods;
+typedef modulo<int, 1000000007, modulo_storage::MONTGOMERY> modm;
+
+template<typename M>
+matrix<M> make_matrix(int n, int m, int seed) {
+    matrix<M> a(n, m);
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < m; j++) {
+            a[i][j] = M(int((int64_t(i * 31 + j + seed) * 1000003 + seed * 12345) % M::M()));
+        }
+    }
+    return a;
+}
+
+template<typename M>
+matrix<M> mul_long(const matrix<M>& m1, const matrix<M>& m2) {
+    matrix<M> r(m1.rows(), m2.cols());
+    matrix<M>::_mul_long(r, m1, m2);
+    return r;
+}
+
+template<typename M>
+void test_mul() {
+    for (int n : { 1, 7, 8, 33 }) {
+        for (int m : { 1, 8, 70 }) {
+            for (int p : { 8, 9, 300 }) {
+                auto a = make_matrix<M>(n, m, 1), b = make_matrix<M>(m, p, 2);
+                EXPECT_EQ(mul_long(a, b), a * b) << "n=" << n << " m=" << m << " p=" << p;
+            }
+        }
+    }
+    // the largest residues
+    matrix<M> c(50, 50, M(-1));
+    EXPECT_EQ(mul_long(c, c), c * c);
+    auto d = make_matrix<M>(40, 40, 3);
+    EXPECT_EQ(mul_long(d, d), d * d);
+}
+}
+
+TEST(matrix_mod_test, mul) {
+    test_mul<mod>();
+    test_mul<modb>();
+    test_mul<mod3>();
+    test_mul<mods>();
+    test_mul<modm>();
+}
+
+TEST(matrix_mod_test, mul_blocked) {
+    int cols = matrix_mul<mod>::block_cols();
+    for (int jb : { 1, 5, 16 }) {
+        matrix_mul<mod>::block_cols() = jb;
+        auto a = make_matrix<mod>(20, 30, 1), b = make_matrix<mod>(30, 37, 2);
+        EXPECT_EQ(mul_long(a, b), a * b) << "jb=" << jb;
+    }
+    matrix_mul<mod>::block_cols() = cols;
+}
+
+TEST(matrix_mod_test, power) {
+    auto a = make_matrix<mod>(30, 30, 1);
+    auto e = matrix<mod>::identity(30, 1);
+    for (int i = 0; i < 13; i++) e = mul_long(e, a);
+    EXPECT_EQ(e, powT(a, 13));
+    auto am = make_matrix<modm>(30, 30, 1);
+    auto em = matrix<modm>::identity(30, 1);
+    for (int i = 0; i < 13; i++) em = mul_long(em, am);
+    EXPECT_EQ(em, powT(am, 13));
+    for (int i = 0; i < 30; i++) {
+        for (int j = 0; j < 30; j++) {
+            EXPECT_EQ(e[i][j].v, em[i][j].v);
+        }
+    }
+}
+
+TEST(matrix_mod_test, mul_parallel) {
+    int num_threads = altruct::concurrency::default_num_threads();
+    int64_t threshold = matrix_mul<mod>::parallel_threshold();
+    int64_t threshold_m = matrix_mul<modm>::parallel_threshold();
+    auto a = make_matrix<mod>(45, 30, 1), b = make_matrix<mod>(30, 37, 2);
+    auto am = make_matrix<modm>(45, 45, 1);
+    auto e = mul_long(a, b);
+    auto em = powT(am, 5);
+    matrix_mul<mod>::parallel_threshold() = 0;
+    matrix_mul<modm>::parallel_threshold() = 0;
+    // the result does not depend on the number of threads, even with more threads than rows
+    for (int t : { 1, 2, 3, 8, 64 }) {
+        altruct::concurrency::default_num_threads() = t;
+        EXPECT_EQ(e, a * b) << "t=" << t;
+        EXPECT_EQ(em, powT(am, 5)) << "t=" << t;
+    }
+    altruct::concurrency::default_num_threads() = num_threads;
+    matrix_mul<mod>::parallel_threshold() = threshold;
+    matrix_mul<modm>::parallel_threshold() = threshold_m;
+}
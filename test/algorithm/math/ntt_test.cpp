@@ -0,0 +1,231 @@
+﻿#include "altruct/algorithm/math/ntt.h"
+#include "altruct/algorithm/math/fft.h"
+#include "altruct/structure/math/modulo.h"
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+using namespace std;
+using namespace altruct::math;
+
+namespace {
+typedef modulo<int, 998244353, modulo_storage::CONSTANT> mod;
+typedef modulo<int, 12289, modulo_storage::CONSTANT> mods;
+typedef modulo<int, 1000000007, modulo_storage::CONSTANT> modn;
+
+template<typename M>
+vector<M> slow_convolution(const vector<M>& u, const vector<M>& v) {
+    vector<M> r(u.size() + v.size() - 1);
+    for (int i = 0; i < (int)u.size(); i++) {
+        for (int j = 0; j < (int)v.size(); j++) {
+            r[i + j] += u[i] * v[j];
+        }
+    }
+    return r;
+}
+
+template<typename M>
+vector<M> make_data(int n, int seed) {
+    vector<M> v(n);
+    for (int i = 0; i < n; i++) v[i] = M(int((int64_t(i + seed) * 1000003 + 12345) % M::M()));
+    return v;
+}
+}
+
+TEST(ntt_test, roots) {
+    const auto& tbl = ntt_roots<mod>::get(mod(1), 16);
+    EXPECT_EQ(23, tbl.max_log);
+    EXPECT_EQ(1 << 23, tbl.max_size());
+    EXPECT_EQ(mod(1), powT(tbl.root, 1 << 23));
+    EXPECT_EQ(mod(-1), powT(tbl.root, 1 << 22));
+    EXPECT_GE((int)tbl.roots.size(), 16);
+    for (int h = 1; h < 16; h *= 2) {
+        mod w = powT(tbl.root, (1 << 23) / (h * 2));
+        for (int j = 0; j < h; j++) {
+            EXPECT_EQ(powT(w, j), tbl.roots[h + j]);
+            EXPECT_EQ(mod(1), tbl.roots[h + j] * tbl.iroots[h + j]);
+        }
+    }
+    EXPECT_EQ(12, (ntt_roots<mods>::get(mods(1)).max_log));
+    EXPECT_EQ(1, (ntt_roots<modn>::get(modn(1)).max_log));
+}
+
+TEST(ntt_test, roots_cache) {
+    typedef modulo<int, 2, modulo_storage::STATIC> modr;
+    modr::M() = 998244353;
+    const auto& tbl1 = ntt_roots<modr>::get(modr(1), 16);
+    auto roots1 = tbl1.roots;
+    modr::M() = 469762049;
+    const auto& tbl2 = ntt_roots<modr>::get(modr(1), 1024);
+    EXPECT_EQ(26, tbl2.max_log);
+    EXPECT_EQ(roots1, tbl1.roots);
+    modr::M() = 998244353;
+    EXPECT_EQ(&tbl1, &ntt_roots<modr>::get(modr(1), 8));
+    const auto& tbl3 = ntt_roots<modr>::get(modr(1), 64);
+    EXPECT_GE((int)tbl3.roots.size(), 64);
+    EXPECT_EQ(roots1, tbl1.roots);
+    EXPECT_EQ(&tbl3, &ntt_roots<modr>::get(modr(1), 32));
+}
+
+TEST(ntt_test, roots_cache_threads) {
+    typedef modulo<int, 469762049, modulo_storage::CONSTANT> modt;
+    vector<vector<modt>> r(12), e(12);
+    for (int i = 0; i < 12; i++) {
+        auto u = make_data<modt>(1 << i, i), v = make_data<modt>(1 << i, i + 1);
+        e[i] = slow_convolution(u, v);
+        e[i].resize(1 << (i + 1));
+    }
+    altruct::concurrency::parallel_range(0, 12, [&](int i0, int i1) {
+        for (int i = i0; i < i1; i++) {
+            auto u = make_data<modt>(1 << i, i), v = make_data<modt>(1 << i, i + 1);
+            u.resize(1 << (i + 1)), v.resize(1 << (i + 1));
+            r[i].resize(1 << (i + 1));
+            ntt_cyclic_convolution(r[i].data(), u.data(), v.data(), 1 << (i + 1));
+        }
+    }, 12);
+    EXPECT_EQ(e, r);
+}
+
+TEST(ntt_test, dif_dit) {
+    for (int n = 1; n <= 256; n *= 2) {
+        const auto& tbl = ntt_roots<mod>::get(mod(1), n);
+        auto a = make_data<mod>(n, n);
+        auto e = a;
+        // compare against the reference transform in bit-reversed order
+        vector<mod> f(n);
+        fft_rec(f.data(), e.data(), n, powT(tbl.root, tbl.max_size() / n));
+        ntt_dif(a.data(), n, tbl);
+        for (int i = 0, j = 0; i < n; i++) {
+            EXPECT_EQ(f[j], a[i]) << "n=" << n << " i=" << i;
+            for (int k = n / 2; k > 0 && ((j ^= k) & k) == 0; k /= 2);
+        }
+        ntt_dit(a.data(), n, tbl);
+        for (auto& x : a) x /= mod(n);
+        EXPECT_EQ(e, a) << "n=" << n;
+    }
+}
+
+TEST(ntt_test, ntt_cyclic_convolution) {
+    const int n = 16;
+    mods u[n] = { 671, 9230, 3302, 4764, 6135, 7750, 9881, 1189, 411, 8144 };
+    mods v[n] = { 8468, 3944, 4798, 6405, 8016, 8884, 1006, 54, 7066, 3531 };
+    mods e[n];
+    for (int k = 0; k < n; k++) {
+        for (int i = 0; i < n; i++) {
+            e[k] += u[i] * v[modT(k - i, n)];
+        }
+    }
+    mods a[n];
+    ntt_cyclic_convolution(a, u, v, n);
+    EXPECT_EQ(vector<mods>(e, e + n), vector<mods>(a, a + n));
+}
+
+TEST(ntt_test, ntt_convolution) {
+    for (int l1 = 1; l1 <= 70; l1 += 23) {
+        for (int l2 = 1; l2 <= 70; l2 += 17) {
+            auto u = make_data<mod>(l1, 1), v = make_data<mod>(l2, 2);
+            EXPECT_EQ(slow_convolution(u, v), ntt_convolution<mod>(u.begin(), u.end(), v.begin(), v.end()));
+            auto us = make_data<mods>(l1, 3), vs = make_data<mods>(l2, 4);
+            EXPECT_EQ(slow_convolution(us, vs), ntt_convolution<mods>(us.begin(), us.end(), vs.begin(), vs.end()));
+        }
+    }
+    auto u = make_data<mod>(100, 5);
+    EXPECT_EQ(slow_convolution(u, u), ntt_convolution<mod>(u.begin(), u.end(), u.begin(), u.end()));
+}
+
+TEST(ntt_test, simd) {
+    typedef modulo<int, 1, modulo_storage::STATIC> modr;
+    modr::M() = 469762049; // 7 * 2^26 + 1
+    bool enabled = simd_enabled();
+    for (int n = 1; n <= 4096; n *= 2) {
+        const auto& tbl = ntt_roots<mod>::get(mod(1), n);
+        const auto& tblr = ntt_roots<modr>::get(modr(1), n);
+        if (cpu_has_avx2()) {
+            EXPECT_NE(nullptr, tbl.simd_twiddles.get());
+            EXPECT_NE(nullptr, tblr.simd_twiddles.get());
+        }
+        auto a = make_data<mod>(n, n), b = a;
+        auto ar = make_data<modr>(n, n), br = ar;
+        simd_enabled() = false;
+        ntt_dif(a.data(), n, tbl);
+        ntt_dif(ar.data(), n, tblr);
+        simd_enabled() = enabled;
+        ntt_dif(b.data(), n, tbl);
+        ntt_dif(br.data(), n, tblr);
+        EXPECT_EQ(a, b) << "n=" << n;
+        EXPECT_EQ(ar, br) << "n=" << n;
+        simd_enabled() = false;
+        ntt_dit(a.data(), n, tbl);
+        ntt_dit(ar.data(), n, tblr);
+        simd_enabled() = enabled;
+        ntt_dit(b.data(), n, tbl);
+        ntt_dit(br.data(), n, tblr);
+        EXPECT_EQ(a, b) << "n=" << n;
+        EXPECT_EQ(ar, br) << "n=" << n;
+    }
+}
+
+TEST(ntt_test, four_step) {
+    int threshold = ntt_four_step_threshold();
+    int num_threads = altruct::concurrency::default_num_threads();
+    for (int n = 1; n <= (1 << 14); n *= 2) {
+        const auto& tbl = ntt_roots<mod>::get(mod(1), n);
+        auto a = make_data<mod>(n, n);
+        auto e = a;
+        ntt_four_step_threshold() = 1 << 30;
+        ntt_dif(e.data(), n, tbl);
+        for (int t : { 1, 3 }) {
+            altruct::concurrency::default_num_threads() = t;
+            for (int m : { 4, 64 }) {
+                ntt_four_step_threshold() = m;
+                auto b = a;
+                ntt_dif(b.data(), n, tbl);
+                EXPECT_EQ(e, b) << "n=" << n << " t=" << t << " m=" << m;
+                ntt_dit(b.data(), n, tbl);
+                for (auto& x : b) x /= mod(n);
+                EXPECT_EQ(a, b) << "n=" << n << " t=" << t << " m=" << m;
+            }
+        }
+    }
+    altruct::concurrency::default_num_threads() = num_threads;
+    ntt_four_step_threshold() = threshold;
+}
+
+TEST(ntt_test, perf) {
+    return; // skip perf tests
+
+    const int n = 1 << 20;
+    const auto& tbl = ntt_roots<mod>::get(mod(1), n);
+    mod root = powT(tbl.root, tbl.max_size() / n);
+    auto a = make_data<mod>(n, 1);
+    vector<mod> t(n);
+    auto T0 = clock();
+    for (int i = 0; i < 10; i++)
+        fft_rec(t.data(), a.data(), n, root);
+    cout << "fft_rec: " << clock() - T0 << " ms" << endl;
+    auto T1 = clock();
+    for (int i = 0; i < 10; i++)
+        fft(a.data(), n, root);
+    cout << "fft: " << clock() - T1 << " ms" << endl;
+    auto T2 = clock();
+    for (int i = 0; i < 10; i++)
+        ntt_dif(a.data(), n, tbl), ntt_dit(a.data(), n, tbl);
+    cout << "ntt_dif + ntt_dit: " << clock() - T2 << " ms" << endl;
+    bool enabled = simd_enabled();
+    simd_enabled() = false;
+    auto T3 = clock();
+    for (int i = 0; i < 10; i++)
+        ntt_dif(a.data(), n, tbl), ntt_dit(a.data(), n, tbl);
+    cout << "ntt_dif + ntt_dit scalar: " << clock() - T3 << " ms" << endl;
+    simd_enabled() = enabled;
+    int threshold = ntt_four_step_threshold();
+    for (int m : { 1 << 30, 1 << 16 }) {
+        ntt_four_step_threshold() = m;
+        auto T4 = clock();
+        for (int i = 0; i < 10; i++)
+            ntt_dif(a.data(), n, tbl), ntt_dit(a.data(), n, tbl);
+        cout << "ntt_dif + ntt_dit four-step threshold " << m << ": " << clock() - T4 << " ms" << endl;
+    }
+    ntt_four_step_threshold() = threshold;
+}
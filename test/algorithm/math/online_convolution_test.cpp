@@ -0,0 +1,54 @@
+﻿#include "altruct/algorithm/math/online_convolution.h"
+#include "altruct/algorithm/math/polynom_mod.h"
+#include "altruct/structure/math/modulo.h"
+
+#include "gtest/gtest.h"
+
+using namespace std;
+using namespace altruct::math;
+
+namespace {
+typedef modulo<int, 998244353, modulo_storage::CONSTANT> mod;
+typedef modulo<int, 1000000007, modulo_storage::CONSTANT> modn;
+
+template<typename T>
+void test_product(int n) {
+    polynom<T> f, g;
+    for (int i = 0; i < n; i++) f[i] = T(i * 12345 + 678), g[i] = T(i * 54321 + 876);
+    auto e = f * g;
+    online_convolution<T> oc;
+    vector<T> h;
+    for (int i = 0; i < n; i++) h.push_back(oc.push(f[i], g[i]));
+    EXPECT_EQ(n, oc.size());
+    EXPECT_EQ(vector<T>(e.c.begin(), e.c.begin() + n), h);
+}
+}
+
+TEST(online_convolution_test, push) {
+    online_convolution<int> oc;
+    vector<int> h;
+    vector<int> f{ 1, 2, 3, 4, 5 }, g{ 3, -1, 4, 1, -5 };
+    for (int i = 0; i < 5; i++) h.push_back(oc.push(f[i], g[i]));
+    EXPECT_EQ((vector<int>{ 3, 5, 11, 18, 20 }), h);
+    test_product<int64_t>(100);
+    test_product<mod>(3000);
+    test_product<modn>(3000);
+}
+
+TEST(online_convolution_test, catalan) {
+    // c = 1 + x c^2
+    online_convolution<int> oc;
+    vector<int> c{ 1 };
+    for (int n = 1; n < 15; n++) c.push_back(oc.push(c[n - 1], c[n - 1]));
+    EXPECT_EQ((vector<int>{ 1, 1, 2, 5, 14, 42, 132, 429, 1430, 4862, 16796, 58786, 208012, 742900, 2674440 }), c);
+    // check against the closed form c[n] = (2n)! / n! / (n+1)!
+    int N = 5000;
+    online_convolution<mod> ocm;
+    vector<mod> cm{ 1 };
+    for (int n = 1; n < N; n++) cm.push_back(ocm.push(cm[n - 1], cm[n - 1]));
+    mod e = 1;
+    for (int n = 0; n < N; n++) {
+        EXPECT_EQ(e, cm[n]);
+        e = e * mod(2 * (2 * n + 1)) / mod(n + 2);
+    }
+}
@@ -0,0 +1,120 @@
+﻿#include "altruct/algorithm/math/polynom_fft.h"
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+using namespace std;
+using namespace altruct::math;
+
+namespace {
+polynom<double> make_poly(int l, int seed) {
+    polynom<double> p;
+    for (int i = l; i >= 0; i--) p[i] = ((i + seed) * 37 % 101) / 101.0 - 0.5;
+    return p;
+}
+
+template<typename F>
+polynom<double> do_mul(F mul, const polynom<double>& p1, const polynom<double>& p2, int lr = -1) {
+    int l1 = p1.deg(), l2 = p2.deg(); if (lr < 0) lr = l1 + l2;
+    polynom<double> pr; pr.resize(lr + 1);
+    mul(pr.c.data(), lr, p1.c.data(), l1, p2.c.data(), l2);
+    return pr;
+}
+
+void expect_near(const polynom<double>& e, const polynom<double>& a, double eps) {
+    ASSERT_EQ(e.deg(), a.deg());
+    for (int i = 0; i <= e.deg(); i++) EXPECT_NEAR(e[i], a[i], eps) << "i=" << i;
+}
+
+typedef complex<double> cplx;
+
+polynom<cplx> make_cpoly(int l, int seed) {
+    polynom<cplx> p;
+    for (int i = l; i >= 0; i--) p[i] = cplx(((i + seed) * 37 % 101) / 101.0 - 0.5, ((i + seed) * 53 % 103) / 103.0 - 0.5);
+    return p;
+}
+
+template<typename F>
+polynom<cplx> do_cmul(F mul, const polynom<cplx>& p1, const polynom<cplx>& p2, int lr = -1) {
+    int l1 = p1.deg(), l2 = p2.deg(); if (lr < 0) lr = l1 + l2;
+    polynom<cplx> pr; pr.resize(lr + 1);
+    mul(pr.c.data(), lr, p1.c.data(), l1, p2.c.data(), l2);
+    return pr;
+}
+
+double max_error(const polynom<cplx>& e, const polynom<cplx>& a) {
+    double err = 0;
+    for (int i = 0; i <= e.deg(); i++) err = max(err, hypot(e[i].a - a[i].a, e[i].b - a[i].b));
+    return err;
+}
+
+void expect_near(const polynom<cplx>& e, const polynom<cplx>& a, double eps) {
+    ASSERT_EQ(e.deg(), a.deg());
+    EXPECT_LE(max_error(e, a), eps);
+}
+}
+
+TEST(polynom_fft_test, mul_fft) {
+    typedef polynom_mul<double> pm;
+    for (int l1 : { 0, 1, 16, 100, 255, 1000 }) {
+        for (int l2 : { 0, 1, 17, 256, 700 }) {
+            if (l2 > l1) continue;
+            auto p1 = make_poly(l1, 1), p2 = make_poly(l2, 2);
+            auto e = do_mul(polynom<double>::_mul_long, p1, p2);
+            expect_near(e, do_mul(pm::_mul_fft, p1, p2), 1e-9);
+            expect_near(polynom<double>(e.c.begin(), e.c.begin() + l1 + 1), do_mul(pm::_mul_fft, p1, p2, l1), 1e-9);
+            expect_near(do_mul(polynom<double>::_mul_long, p1, p1), do_mul(pm::_mul_fft, p1, p1), 1e-9);
+        }
+    }
+}
+
+TEST(polynom_fft_test, mul) {
+    auto p1 = make_poly(1000, 1), p2 = make_poly(700, 2);
+    expect_near(do_mul(polynom<double>::_mul_long, p1, p2), p1 * p2, 1e-9);
+    expect_near(do_mul(polynom<double>::_mul_long, p1, p1), p1 * p1, 1e-9);
+    auto p3 = p1; p3 *= p3;
+    expect_near(do_mul(polynom<double>::_mul_long, p1, p1), p3, 1e-9);
+}
+
+TEST(polynom_fft_test, mul_fft_complex) {
+    typedef polynom_mul<cplx> pm;
+    for (int l1 : { 0, 1, 16, 100, 255, 1000 }) {
+        for (int l2 : { 0, 1, 17, 256, 700 }) {
+            if (l2 > l1) continue;
+            auto p1 = make_cpoly(l1, 1), p2 = make_cpoly(l2, 2);
+            auto e = do_cmul(polynom<cplx>::_mul_long, p1, p2);
+            expect_near(e, do_cmul(pm::_mul_fft, p1, p2), 1e-9);
+            expect_near(polynom<cplx>(e.c.begin(), e.c.begin() + l1 + 1), do_cmul(pm::_mul_fft, p1, p2, l1), 1e-9);
+            expect_near(do_cmul(polynom<cplx>::_mul_long, p1, p1), do_cmul(pm::_mul_fft, p1, p1), 1e-9);
+        }
+    }
+}
+
+TEST(polynom_fft_test, mul_complex) {
+    auto p1 = make_cpoly(1000, 1), p2 = make_cpoly(700, 2);
+    expect_near(do_cmul(polynom<cplx>::_mul_long, p1, p2), p1 * p2, 1e-9);
+    expect_near(do_cmul(polynom<cplx>::_mul_long, p1, p1), p1 * p1, 1e-9);
+    auto p3 = p1; p3 *= p3;
+    expect_near(do_cmul(polynom<cplx>::_mul_long, p1, p1), p3, 1e-9);
+}
+
+TEST(polynom_fft_test, error_bound) {
+    typedef polynom_mul<double> pm;
+    for (double scale : { 1.0, 1e-8, 1e8 }) {
+        auto p1 = make_poly(3000, 1), p2 = make_poly(2000, 2) * scale;
+        auto e = do_mul(polynom<double>::_mul_long, p1, p2), a = do_mul(pm::_mul_fft, p1, p2);
+        double err = 0; for (int i = 0; i <= e.deg(); i++) err = max(err, fabs(e[i] - a[i]));
+        double bound = pm::error_bound(p1.c.data(), p1.deg(), p2.c.data(), p2.deg());
+        // the operands are balanced, so the error is relative to the scale
+        EXPECT_LE(err, bound);
+        EXPECT_LE(bound, 1e-10 * scale);
+    }
+    typedef polynom_mul<cplx> pmc;
+    auto q1 = make_cpoly(3000, 1), q2 = make_cpoly(2000, 2);
+    double err = max_error(do_cmul(polynom<cplx>::_mul_long, q1, q2), do_cmul(pmc::_mul_fft, q1, q2));
+    double bound = pmc::error_bound(q1.c.data(), q1.deg(), q2.c.data(), q2.deg());
+    EXPECT_LE(err, bound);
+    EXPECT_LE(bound, 1e-9);
+    EXPECT_EQ(0.0, fft_mul_error_bound(1024, 0.0, 1.0));
+}
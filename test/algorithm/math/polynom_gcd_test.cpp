@@ -0,0 +1,108 @@
+﻿#include "altruct/algorithm/math/polynom_gcd.h"
+#include "altruct/algorithm/math/polynom_mod.h"
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+using namespace std;
+using namespace altruct::math;
+
+namespace {
+typedef modulo<int, 998244353, modulo_storage::CONSTANT> mod;
+
+polynom<mod> make_poly(int l, int seed) {
+    polynom<mod> p;
+    for (int i = l; i >= 0; i--) p[i] = mod(int((int64_t(i + seed) * (i + seed) * 1000003 + seed * 12345) % mod::M()));
+    if (p[l] == mod(0)) p[l] = 1;
+    return p;
+}
+
+int deg(const polynom<mod>& p) { return polynom_gcd_deg(p); }
+
+// the remainder sequence by the plain Euclidean algorithm, up to the first remainder of degree less than `m`
+void naive_half_gcd(polynom<mod>& c, polynom<mod>& d, int m) {
+    while (deg(d) >= m) {
+        polynom<mod> r = c % d;
+        c.swap(d); d.swap(r);
+    }
+}
+
+polynom<mod> monic(const polynom<mod>& p) {
+    return (deg(p) < 0) ? p : p / p.leading_coeff();
+}
+}
+
+TEST(polynom_gcd_test, half_gcd) {
+    int threshold = half_gcd_threshold();
+    for (int t : { 1, 2, 5, 64 }) {
+        half_gcd_threshold() = t;
+        for (int n : { 0, 1, 2, 3, 10, 33, 100, 257 }) {
+            for (int l : { -1, 0, 1, n / 2, n / 2 + 1, n - 1 }) {
+                if (l >= n) continue;
+                auto a = make_poly(n, 1), b = (l < 0) ? polynom<mod>(0) : make_poly(l, 2);
+                auto M = half_gcd(a, b);
+                auto c = a, d = b;
+                M.apply(c, d);
+                auto ce = a, de = b;
+                naive_half_gcd(ce, de, (n + 1) / 2);
+                EXPECT_EQ(ce, c) << "t=" << t << " n=" << n << " l=" << l;
+                EXPECT_EQ(de, d) << "t=" << t << " n=" << n << " l=" << l;
+                EXPECT_GE(deg(c), (n + 1) / 2);
+                EXPECT_LT(deg(d), (n + 1) / 2);
+            }
+        }
+    }
+    half_gcd_threshold() = threshold;
+}
+
+TEST(polynom_gcd_test, polynom_gcd) {
+    int threshold = half_gcd_threshold();
+    for (int t : { 1, 3, 64 }) {
+        half_gcd_threshold() = t;
+        for (int lg : { 0, 1, 7, 50 }) {
+            for (int la : { 0, 1, 20, 150 }) {
+                for (int lb : { 0, 5, 150 }) {
+                    auto g = monic(make_poly(lg, 3));
+                    auto a = g * make_poly(la, 4), b = g * make_poly(lb, 5);
+                    EXPECT_EQ(g, polynom_gcd(a, b)) << "t=" << t << " lg=" << lg << " la=" << la << " lb=" << lb;
+                    EXPECT_EQ(monic(gcd(a, b)), polynom_gcd(a, b));
+                }
+            }
+        }
+    }
+    half_gcd_threshold() = threshold;
+    auto p = make_poly(10, 1);
+    EXPECT_EQ(monic(p), polynom_gcd(p, polynom<mod>(0)));
+    EXPECT_EQ(monic(p), polynom_gcd(polynom<mod>(0), p));
+    EXPECT_EQ(polynom<mod>(0), polynom_gcd(polynom<mod>(0), polynom<mod>(0)));
+    EXPECT_EQ(polynom<mod>(1), polynom_gcd(p, polynom<mod>(5)));
+}
+
+TEST(polynom_gcd_test, polynom_gcd_ex) {
+    int threshold = half_gcd_threshold();
+    for (int t : { 1, 3, 64 }) {
+        half_gcd_threshold() = t;
+        for (int lg : { 0, 1, 7, 50 }) {
+            for (int la : { 0, 1, 20, 150 }) {
+                for (int lb : { 0, 5, 150 }) {
+                    auto g = monic(make_poly(lg, 3));
+                    auto a = g * make_poly(la, 4), b = g * make_poly(lb, 5);
+                    polynom<mod> x, y;
+                    EXPECT_EQ(g, polynom_gcd_ex(a, b, &x, &y)) << "t=" << t << " lg=" << lg << " la=" << la << " lb=" << lb;
+                    EXPECT_EQ(g, a * x + b * y);
+                    if (lb > 0) { EXPECT_LT(deg(x), lb); }
+                    if (la > 0) { EXPECT_LT(deg(y), la); }
+                }
+            }
+        }
+    }
+    half_gcd_threshold() = threshold;
+    auto p = make_poly(10, 1);
+    polynom<mod> x, y;
+    EXPECT_EQ(monic(p), polynom_gcd_ex(p, polynom<mod>(0), &x, &y));
+    EXPECT_EQ(monic(p), p * x + polynom<mod>(0) * y);
+    EXPECT_EQ(monic(p), polynom_gcd_ex(polynom<mod>(0), p, &x, &y));
+    EXPECT_EQ(monic(p), polynom<mod>(0) * x + p * y);
+    EXPECT_EQ(polynom<mod>(0), polynom_gcd_ex(polynom<mod>(0), polynom<mod>(0), &x, &y));
+}
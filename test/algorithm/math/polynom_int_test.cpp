@@ -0,0 +1,87 @@
+﻿#include "altruct/algorithm/math/polynom_int.h"
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+using namespace std;
+using namespace altruct::math;
+
+namespace {
+typedef long long ll;
+typedef unsigned long long ull;
+
+template<typename I>
+polynom<I> make_poly(int l, int seed, I m, bool neg) {
+    polynom<I> p;
+    for (int i = l; i >= 0; i--) {
+        I v = I((uint64_t(i + seed) * 0x9E3779B97F4A7C15ULL >> 20) % uint64_t(m));
+        p[i] = (neg && (i + seed) % 3 == 0) ? I(0) - v : v;
+    }
+    return p;
+}
+
+template<typename P, typename F>
+P do_mul(F mul, const P& p1, const P& p2, int lr = -1) {
+    int l1 = p1.deg(), l2 = p2.deg(); if (lr < 0) lr = l1 + l2;
+    P pr; pr.resize(lr + 1);
+    mul(pr.c.data(), lr, p1.c.data(), l1, p2.c.data(), l2);
+    return pr;
+}
+}
+
+TEST(polynom_int_test, is_bounded) {
+    typedef polynom_mul<ll> pm;
+    vector<ll> a{ 3, -(1LL << 31), 5 }, b{ 1LL << 29, 7 };
+    // 2^31 * 2^29 * 2 = 2^61
+    EXPECT_TRUE(pm::is_bounded(a.data(), 2, b.data(), 1));
+    b[1] = -(1LL << 31);
+    // 2^31 * 2^31 * 2 = 2^63
+    EXPECT_FALSE(pm::is_bounded(a.data(), 2, b.data(), 1));
+    EXPECT_TRUE(pm::is_bounded(a.data(), 2, b.data(), 0));
+    vector<ll> z{ 0, 0 };
+    EXPECT_TRUE(pm::is_bounded(a.data(), 2, z.data(), 1));
+    vector<ull> u{ 1ULL << 32, 5 }, v{ (1ULL << 31) - 1, 1ULL << 31 };
+    // 2^32 * 2^31 * 2 = 2^64
+    EXPECT_FALSE(polynom_mul<ull>::is_bounded(u.data(), 1, v.data(), 1));
+    EXPECT_TRUE(polynom_mul<ull>::is_bounded(u.data(), 1, v.data(), 0));
+}
+
+TEST(polynom_int_test, mul_ntt3) {
+    typedef polynom_mul<ll> pm;
+    for (int l1 : { 0, 1, 16, 100, 1000, 3000 }) {
+        for (int l2 : { 0, 1, 17, 256, 2000 }) {
+            if (l2 > l1) continue;
+            auto p1 = make_poly<ll>(l1, 1, 1LL << 25, true), p2 = make_poly<ll>(l2, 2, 1LL << 25, true);
+            auto e = do_mul(polynom<ll>::_mul_long, p1, p2);
+            EXPECT_EQ(e, do_mul(pm::_mul_ntt3, p1, p2));
+            EXPECT_EQ(polynom<ll>(e.c.begin(), e.c.begin() + l1 + 1), do_mul(pm::_mul_ntt3, p1, p2, l1));
+            EXPECT_EQ(do_mul(polynom<ll>::_mul_long, p1, p1), do_mul(pm::_mul_ntt3, p1, p1));
+        }
+    }
+    // close to the bound, 2^31 * (2^31 - 1) * 2 < 2^63
+    vector<ll> a{ -(1LL << 31), (1LL << 31) - 1 }, b{ (1LL << 31) - 1, -(1LL << 31) + 1 };
+    polynom<ll> pa(a), pb(b);
+    EXPECT_TRUE(pm::is_bounded(a.data(), 1, b.data(), 1));
+    EXPECT_EQ(do_mul(polynom<ll>::_mul_long, pa, pb), do_mul(pm::_mul_ntt3, pa, pb));
+}
+
+TEST(polynom_int_test, mul_ntt3_unsigned) {
+    typedef polynom_mul<ull> pm;
+    auto p1 = make_poly<ull>(2000, 1, 1ULL << 26, false), p2 = make_poly<ull>(1500, 2, 1ULL << 26, false);
+    EXPECT_EQ(do_mul(polynom<ull>::_mul_long, p1, p2), do_mul(pm::_mul_ntt3, p1, p2));
+    // close to the bound, 3037000499^2 * 2 < 2^64
+    vector<ull> a{ 3037000499ULL, 3037000499ULL };
+    polynom<ull> pa(a);
+    EXPECT_TRUE(pm::is_bounded(pa.c.data(), 1, pa.c.data(), 1));
+    EXPECT_EQ(do_mul(polynom<ull>::_mul_long, pa, pa), do_mul(pm::_mul_ntt3, pa, pa));
+}
+
+TEST(polynom_int_test, mul) {
+    // bounded, by NTT
+    auto p1 = make_poly<ll>(5000, 1, 1LL << 20, true), p2 = make_poly<ll>(4000, 2, 1LL << 20, true);
+    EXPECT_EQ(do_mul(polynom<ll>::_mul_long, p1, p2), p1 * p2);
+    // not bounded, by Karatsuba, which wraps around as the schoolbook does
+    auto q1 = make_poly<ull>(5000, 1, ~0ULL, false), q2 = make_poly<ull>(4000, 2, ~0ULL, false);
+    EXPECT_EQ(do_mul(polynom<ull>::_mul_long, q1, q2), q1 * q2);
+}
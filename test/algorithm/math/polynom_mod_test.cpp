@@ -0,0 +1,288 @@
+﻿#include "altruct/algorithm/math/polynom_mod.h"
+#include "altruct/structure/math/series.h"
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+using namespace std;
+using namespace altruct::math;
+
+namespace {
+typedef modulo<int, 998244353, modulo_storage::CONSTANT> mod;
+typedef modulo<int, 1000000007, modulo_storage::CONSTANT> modn;
+typedef modulo<int, 998244353, modulo_storage::MONTGOMERY> modm;
+
+template<typename M>
+polynom<M> make_poly(int l, int seed) {
+    polynom<M> p;
+    for (int i = l; i >= 0; i--) p[i] = M(int((int64_t(i + seed) * 1000003 + 12345) % M::M()));
+    return p;
+}
+
+template<typename M, typename F>
+polynom<M> do_mul(F mul, const polynom<M>& p1, const polynom<M>& p2, int lr = -1) {
+    int l1 = p1.deg(), l2 = p2.deg(); if (lr < 0) lr = l1 + l2;
+    polynom<M> pr; pr.resize(lr + 1);
+    mul(pr.c.data(), lr, p1.c.data(), l1, p2.c.data(), l2);
+    return pr;
+}
+}
+
+TEST(polynom_mod_test, mul_ntt) {
+    typedef polynom_mul<mod> pm;
+    EXPECT_TRUE(pm::is_ntt_friendly(1000, 1000));
+    EXPECT_TRUE(pm::is_ntt_friendly((1 << 22) - 1, (1 << 22) - 1));
+    EXPECT_FALSE(pm::is_ntt_friendly(1 << 22, 1 << 22));
+    for (int l1 : { 16, 100, 255, 300 }) {
+        for (int l2 : { 16, 99, 256 }) {
+            if (l2 > l1) continue;
+            auto p1 = make_poly<mod>(l1, 1), p2 = make_poly<mod>(l2, 2);
+            auto e = do_mul<mod>(pm::_mul_long, p1, p2);
+            EXPECT_EQ(e, do_mul<mod>(pm::_mul_ntt, p1, p2));
+            EXPECT_EQ(polynom<mod>(e.c.begin(), e.c.begin() + l1 + 1), do_mul<mod>(pm::_mul_ntt, p1, p2, l1));
+            EXPECT_EQ(do_mul<mod>(pm::_mul_long, p1, p1), do_mul<mod>(pm::_mul_ntt, p1, p1));
+        }
+    }
+}
+
+TEST(polynom_mod_test, mul) {
+    auto p1 = make_poly<mod>(1000, 1), p2 = make_poly<mod>(700, 2);
+    EXPECT_EQ(do_mul<mod>(polynom_mul<mod>::_mul_long, p1, p2), p1 * p2);
+    auto q1 = make_poly<modn>(1000, 1), q2 = make_poly<modn>(700, 2);
+    EXPECT_FALSE(polynom_mul<modn>::is_ntt_friendly(1000, 700));
+    EXPECT_EQ(do_mul<modn>(polynom_mul<modn>::_mul_long, q1, q2), q1 * q2);
+    EXPECT_EQ(do_mul<modn>(polynom_mul<modn>::_mul_long, q1, q2), do_mul<modn>(polynom_mul<modn>::_mul_fft, q1, q2));
+    EXPECT_EQ(do_mul<modn>(polynom_mul<modn>::_mul_long, q1, q2), do_mul<modn>(polynom_mul<modn>::_mul_fft_big, q1, q2));
+}
+
+TEST(polynom_mod_test, mul_ntt3) {
+    typedef modulo<int, 2147483647, modulo_storage::CONSTANT> modb;
+    EXPECT_TRUE(polynom_mul<modn>::is_ntt3_friendly((1 << 22), (1 << 22) - 1));
+    EXPECT_FALSE(polynom_mul<modn>::is_ntt3_friendly((1 << 22), (1 << 22)));
+    for (int l1 : { 0, 16, 300, 1000 }) {
+        for (int l2 : { 0, 17, 700 }) {
+            if (l2 > l1) continue;
+            auto q1 = make_poly<modn>(l1, 1), q2 = make_poly<modn>(l2, 2);
+            EXPECT_EQ(do_mul<modn>(polynom_mul<modn>::_mul_long, q1, q2), do_mul<modn>(polynom_mul<modn>::_mul_ntt3, q1, q2));
+            EXPECT_EQ(do_mul<modn>(polynom_mul<modn>::_mul_long, q1, q1), do_mul<modn>(polynom_mul<modn>::_mul_ntt3, q1, q1));
+            auto b1 = make_poly<modb>(l1, 1), b2 = make_poly<modb>(l2, 2);
+            EXPECT_EQ(do_mul<modb>(polynom_mul<modb>::_mul_long, b1, b2), do_mul<modb>(polynom_mul<modb>::_mul_ntt3, b1, b2));
+        }
+    }
+    auto b1 = make_poly<modb>(1000, 1), b2 = make_poly<modb>(700, 2);
+    EXPECT_EQ(do_mul<modb>(polynom_mul<modb>::_mul_long, b1, b2), b1 * b2);
+    // largest coefficients; (M - 1)^2 == 1 (mod M)
+    int l1 = 1 << 19, l2 = (1 << 19) - 1;
+    polynom<modb> m1, m2; m1.c.assign(l1 + 1, modb(-1)); m2.c.assign(l2 + 1, modb(-1));
+    auto r = do_mul<modb>(polynom_mul<modb>::_mul_ntt3, m1, m2);
+    int errors = 0;
+    for (int k = 0; k <= l1 + l2; k++) {
+        if (r[k].v != std::min(std::min(k, l2) + 1, l1 + l2 + 1 - k)) errors++;
+    }
+    EXPECT_EQ(0, errors);
+}
+
+TEST(polynom_mod_test, mul_montgomery) {
+    auto p1 = make_poly<modm>(1000, 1), p2 = make_poly<modm>(700, 2);
+    EXPECT_TRUE(polynom_mul<modm>::is_ntt_friendly(1000, 700));
+    auto e = do_mul<modm>(polynom<modm>::_mul_long, p1, p2);
+    EXPECT_EQ(e, p1 * p2);
+    EXPECT_EQ(e, do_mul<modm>(polynom_mul<modm>::_mul_ntt, p1, p2));
+    EXPECT_EQ(e, do_mul<modm>(polynom_mul<modm>::_mul_fft, p1, p2));
+    auto q1 = make_poly<mod>(1000, 1), q2 = make_poly<mod>(700, 2);
+    auto q = q1 * q2;
+    for (int i = 0; i <= 1700; i++) EXPECT_EQ(q[i].v, e[i].v);
+    typedef series<modm, 500> ser;
+    ser s(p1);
+    EXPECT_EQ(ser(modm(1)), s * s.inverse());
+}
+
+TEST(polynom_mod_test, mul_operand) {
+    typedef modulo<int, 2147483647, modulo_storage::CONSTANT> modb;
+    auto p1 = make_poly<mod>(1000, 1), p2 = make_poly<mod>(700, 2);
+    polynom_operand<mod> o2(p2, 1000);
+    EXPECT_EQ(2048, o2.n);
+    polynom<mod> pr;
+    polynom<mod>::mul(pr, p1, o2);
+    EXPECT_EQ(p1 * p2, pr);
+    polynom<mod>::mul(pr, p1, o2, 1200);
+    EXPECT_EQ(do_mul<mod>(polynom_mul<mod>::_mul_long, p1, p2, 1200), pr);
+    polynom<mod>::mul(pr, p1, o2, 2000);
+    EXPECT_EQ(2001, pr.size());
+    EXPECT_EQ(p1 * p2, pr);
+    // different transform size
+    auto p3 = make_poly<mod>(100, 3);
+    polynom<mod>::mul(pr, p3, o2);
+    EXPECT_EQ(p3 * p2, pr);
+    // inplace
+    pr = p1;
+    polynom<mod>::mul(pr, pr, o2);
+    EXPECT_EQ(p1 * p2, pr);
+    // not transformed
+    polynom_operand<mod> o3(p3, 10);
+    EXPECT_EQ(0, o3.n);
+    polynom<mod>::mul(pr, p1, o3);
+    EXPECT_EQ(p1 * p3, pr);
+    // three primes
+    auto q1 = make_poly<modn>(3000, 1), q2 = make_poly<modn>(2500, 2);
+    polynom_operand<modn> oq(q2, 3000);
+    EXPECT_EQ(8192, oq.n);
+    polynom<modn> qr;
+    polynom<modn>::mul(qr, q1, oq);
+    EXPECT_EQ(q1 * q2, qr);
+    polynom<modn>::mul(qr, q1, oq, 2000);
+    EXPECT_EQ(do_mul<modn>(polynom_mul<modn>::_mul_long, q1, q2, 2000), qr);
+    auto b1 = make_poly<modb>(3000, 1), b2 = make_poly<modb>(2500, 2);
+    polynom<modb> br;
+    polynom<modb>::mul(br, b1, polynom_operand<modb>(b2, 3000));
+    EXPECT_EQ(do_mul<modb>(polynom_mul<modb>::_mul_long, b1, b2), br);
+    // Montgomery form
+    auto m1 = make_poly<modm>(1000, 1), m2 = make_poly<modm>(700, 2);
+    polynom<modm> mr;
+    polynom<modm>::mul(mr, m1, polynom_operand<modm>(m2, 1000));
+    EXPECT_EQ(m1 * m2, mr);
+}
+
+TEST(polynom_mod_test, series_inverse) {
+    typedef series<mod, 3000> ser;
+    ser s(make_poly<mod>(2999, 1));
+    EXPECT_EQ(ser(mod(1)), s * s.inverse());
+    typedef series<modn, 3000> sern;
+    sern sn(make_poly<modn>(2999, 1));
+    EXPECT_EQ(sern(modn(1)), sn * sn.inverse());
+}
+
+TEST(polynom_mod_test, mul_middle) {
+    typedef modulo<int, 2147483647, modulo_storage::CONSTANT> modb;
+    for (int l1 : { 0, 100, 1000 }) {
+        for (int l2 : { 0, 70, 700 }) {
+            for (int lo : { 0, 50, 600 }) {
+                for (int hr : { 600, 1100, 2000 }) {
+                    auto p1 = make_poly<mod>(l1, 1), p2 = make_poly<mod>(l2, 2);
+                    auto e = p1 * p2; e.resize(hr + 1);
+                    polynom<mod> pr;
+                    polynom<mod>::mul_middle(pr, p1, p2, lo, hr);
+                    EXPECT_EQ(polynom<mod>(e.c.begin() + lo, e.c.end()), pr);
+                    auto q1 = make_poly<modn>(l1, 1), q2 = make_poly<modn>(l2, 2);
+                    auto eq = q1 * q2; eq.resize(hr + 1);
+                    polynom<modn> qr;
+                    polynom<modn>::mul_middle(qr, q1, q2, lo, hr);
+                    EXPECT_EQ(polynom<modn>(eq.c.begin() + lo, eq.c.end()), qr);
+                }
+            }
+        }
+    }
+    auto b1 = make_poly<modb>(3000, 1), b2 = make_poly<modb>(2000, 2);
+    auto e = do_mul<modb>(polynom_mul<modb>::_mul_long, b1, b2, 4000);
+    polynom<modb> br;
+    polynom<modb>::mul_middle(br, b1, b2, 2000, 4000);
+    EXPECT_EQ(polynom<modb>(e.c.begin() + 2000, e.c.end()), br);
+    // inplace
+    br = b1;
+    polynom<modb>::mul_middle(br, br, b2, 2000, 4000);
+    EXPECT_EQ(polynom<modb>(e.c.begin() + 2000, e.c.end()), br);
+    auto m1 = make_poly<modm>(1000, 1), m2 = make_poly<modm>(700, 2);
+    auto em = m1 * m2;
+    polynom<modm> mr;
+    polynom<modm>::mul_middle(mr, m1, m2, 500, 1200);
+    EXPECT_EQ(polynom<modm>(em.c.begin() + 500, em.c.begin() + 1201), mr);
+}
+
+TEST(polynom_mod_test, mul_middle_operand) {
+    auto p1 = make_poly<mod>(2047, 1), p2 = make_poly<mod>(1023, 2);
+    polynom_operand<mod> o2(p2, 1023);
+    EXPECT_EQ(2048, o2.n);
+    auto e = p1 * p2;
+    polynom<mod> pr;
+    polynom<mod>::mul_middle(pr, p1, o2, 1024, 2047);
+    EXPECT_EQ(polynom<mod>(e.c.begin() + 1024, e.c.begin() + 2048), pr);
+    polynom<mod>::mul_middle(pr, p1, o2, 0, 2047);
+    EXPECT_EQ(polynom<mod>(e.c.begin(), e.c.begin() + 2048), pr);
+    auto q1 = make_poly<modn>(2047, 1), q2 = make_poly<modn>(1023, 2);
+    polynom_operand<modn> oq(q2, 1023);
+    EXPECT_EQ(2048, oq.n);
+    auto eq = q1 * q2;
+    polynom<modn> qr;
+    polynom<modn>::mul_middle(qr, q1, oq, 1024, 2047);
+    EXPECT_EQ(polynom<modn>(eq.c.begin() + 1024, eq.c.begin() + 2048), qr);
+}
+
+TEST(polynom_mod_test, series_exp) {
+    typedef series<mod, 3000> ser;
+    ser s(make_poly<mod>(2999, 1)); s[0] = 0;
+    EXPECT_EQ(s, s.exp().ln());
+    typedef series<modn, 3000> sern;
+    sern sn(make_poly<modn>(2999, 1)); sn[0] = 0;
+    EXPECT_EQ(sn, sn.exp().ln());
+}
+
+TEST(polynom_mod_test, series_sqrt) {
+    typedef series<mod, 3000> ser;
+    ser s(make_poly<mod>(2999, 1)); s[0] = 1;
+    auto r = s.sqrt();
+    EXPECT_EQ(s, r * r);
+    EXPECT_EQ(ser(mod(1)), s * r.inverse() * r.inverse());
+    EXPECT_EQ(r.inverse(), s.inverse_sqrt());
+    EXPECT_EQ(s.ln() / mod(2), r.ln());
+    typedef series<modn, 3000> sern;
+    sern sn(make_poly<modn>(2999, 1)); sn[0] = 4;
+    auto rn = sn.sqrt(modn(2));
+    EXPECT_EQ(sn, rn * rn);
+    EXPECT_EQ(rn.inverse(), sn.inverse_sqrt(modn(1) / modn(2)));
+}
+
+TEST(polynom_mod_test, quot_rem_newton) {
+    auto p1 = make_poly<mod>(3000, 1), p2 = make_poly<mod>(1000, 2);
+    auto q1 = make_poly<modn>(3000, 1), q2 = make_poly<modn>(1000, 2);
+    polynom<mod> pr, e;
+    polynom<modn> qr, eq;
+    polynom<mod>::quot_rem(pr, p1, p2);
+    polynom<modn>::quot_rem(qr, q1, q2);
+    int threshold = polynom<mod>::newton_div_threshold();
+    polynom<mod>::newton_div_threshold() = 1 << 30;
+    polynom<modn>::newton_div_threshold() = 1 << 30;
+    polynom<mod>::quot_rem(e, p1, p2);
+    polynom<modn>::quot_rem(eq, q1, q2);
+    polynom<mod>::newton_div_threshold() = threshold;
+    polynom<modn>::newton_div_threshold() = threshold;
+    EXPECT_EQ(e, pr);
+    EXPECT_EQ(eq, qr);
+    EXPECT_EQ(p1, p1 / p2 * p2 + p1 % p2);
+    EXPECT_EQ(q1, q1 / q2 * q2 + q1 % q2);
+    EXPECT_EQ(1000, (p1 % p2).size());
+    EXPECT_EQ(2001, (p1 / p2).size());
+}
+
+TEST(polynom_mod_test, divisor) {
+    auto p1 = make_poly<mod>(3000, 1), p2 = make_poly<mod>(1000, 2);
+    auto q1 = make_poly<modn>(3000, 1), q2 = make_poly<modn>(1000, 2);
+    polynom_divisor<mod> d2(p2, 3000);
+    polynom_divisor<modn> dq2(q2, 3000);
+    EXPECT_TRUE(d2.newton);
+    EXPECT_TRUE(dq2.newton);
+    polynom<mod> pr;
+    polynom<modn> qr;
+    polynom<mod>::quot_rem(pr, p1, d2);
+    polynom<modn>::quot_rem(qr, q1, dq2);
+    EXPECT_EQ(p1 / p2, polynom<mod>(pr.c.begin() + 1000, pr.c.end()));
+    EXPECT_EQ(q1 / q2, polynom<modn>(qr.c.begin() + 1000, qr.c.end()));
+    polynom<mod>::mod(pr, p1, d2);
+    polynom<modn>::mod(qr, q1, dq2);
+    EXPECT_EQ(p1 % p2, pr);
+    EXPECT_EQ(q1 % q2, qr);
+}
+
+TEST(polynom_mod_test, powT_moduloX) {
+    typedef moduloX<polynom<mod>> polymod;
+    auto p1 = make_poly<mod>(999, 1), p2 = make_poly<mod>(1000, 2);
+    polymod r(p1, p2), e(polynom<mod>(1), p2);
+    for (int k = 0; k < 5; k++) e *= r;
+    EXPECT_EQ(e.v, powT(r, 5).v);
+    const modulo_reducer<polynom<mod>> reducer(p2);
+    EXPECT_TRUE(reducer.is_for(p2));
+    EXPECT_TRUE(reducer.d.newton);
+    EXPECT_EQ(p1 * p1 % p2, reducer.mul(p1, p1, p2));
+    EXPECT_FALSE(reducer.is_for(p1));
+    EXPECT_EQ(p2 * p2 % p1, reducer.mul(p2, p2, p1));
+}
@@ -1,5 +1,7 @@
 #include "altruct/algorithm/math/polynoms.h"
+#include "altruct/algorithm/math/polynom_mod.h"
 #include "altruct/structure/math/fraction.h"
+#include "altruct/structure/math/modulo.h"
 
 #include "gtest/gtest.h"
 
@@ -43,3 +45,81 @@ TEST(polynoms_test, polynom_sum) {
     EXPECT_EQ((polynom<frac>{0, 1, 3, 2} / frac(6)), polynom_sum(polynom<frac>{ 0, 0, 1 }));
     EXPECT_EQ((polynom<frac>{0, 19, 15, 14} / frac(6)), polynom_sum(polynom<frac>{ 3, -2, 7 }));
 }
+
+TEST(polynoms_test, multipoint_eval) {
+    const polynom<int> p1{ 7, -5, -13, 4 };
+    EXPECT_EQ((vector<int>{}), multipoint_eval(p1, vector<int>{}));
+    EXPECT_EQ((vector<int>{ 7 }), multipoint_eval(p1, vector<int>{ 0 }));
+    EXPECT_EQ((vector<int>{ 7, -7, -5, -23, 7 }), multipoint_eval(p1, vector<int>{ 0, 1, -1, 2, 0 }));
+    typedef modulo<int, 998244353, modulo_storage::CONSTANT> mod;
+    polynom<mod> p;
+    vector<mod> x;
+    for (int i = 0; i < 3000; i++) p[i] = mod(i * 12345 + 678), x.push_back(mod(int((i * 1000003LL + 17) % mod::M())));
+    auto r = multipoint_eval(p, x);
+    for (int i = 0; i < 3000; i++) EXPECT_EQ(p(x[i]), r[i]);
+    x.resize(1000);
+    r = multipoint_eval(p, x);
+    for (int i = 0; i < 1000; i++) EXPECT_EQ(p(x[i]), r[i]);
+}
+
+TEST(polynoms_test, interpolate) {
+    typedef fraction<int> frac;
+    EXPECT_EQ((polynom<frac>{ 5 }), interpolate(vector<frac>{ 3 }, vector<frac>{ 5 }));
+    EXPECT_EQ((polynom<frac>{ 7, -5, -13, 4 }), interpolate(vector<frac>{ 0, 1, -1, 2 }, vector<frac>{ 7, -7, -5, -23 }));
+    EXPECT_EQ((polynom<frac>{ 1, frac(1, 2) }), interpolate(vector<frac>{ 0, 2 }, vector<frac>{ 1, 2 }));
+    typedef modulo<int, 1000000007, modulo_storage::CONSTANT> modn;
+    polynom<modn> p;
+    vector<modn> x, y;
+    for (int i = 0; i < 2000; i++) p[i] = modn(i * 12345 + 678), x.push_back(modn(int((i * 1000003LL + 17) % modn::M())));
+    for (int i = 0; i < 2000; i++) y.push_back(p(x[i]));
+    EXPECT_EQ(p, interpolate(x, y));
+}
+
+TEST(polynoms_test, taylor_shift) {
+    typedef fraction<int> frac;
+    EXPECT_EQ((polynom<frac>{ -23, -9, 11, 4 }), taylor_shift(polynom<frac>{ 7, -5, -13, 4 }, frac(2)));
+    EXPECT_EQ((polynom<frac>{ 7, -5, -13, 4 }), taylor_shift(polynom<frac>{ 7, -5, -13, 4 }, frac(0)));
+    EXPECT_EQ((polynom<frac>{ 5 }), taylor_shift(polynom<frac>{ 5 }, frac(3)));
+    typedef modulo<int, 998244353, modulo_storage::CONSTANT> mod;
+    polynom<mod> p;
+    for (int i = 0; i < 3000; i++) p[i] = mod(i * 12345 + 678);
+    mod c = 1000003;
+    auto q = taylor_shift(p, c);
+    EXPECT_EQ(p.deg(), q.deg());
+    for (int x : { 0, 1, 2, 12345, -7 }) {
+        EXPECT_EQ(p(mod(x) + c), q(mod(x)));
+    }
+    EXPECT_EQ(p, taylor_shift(q, -c));
+}
+
+TEST(polynoms_test, compose) {
+    EXPECT_EQ((polynom<int>{ 1, 2, 5, 6, 3 }), compose(polynom<int>{ 1, 2, 3 }, polynom<int>{ 0, 1, 1 }, 5));
+    EXPECT_EQ((polynom<int>{ 1, 2, 5 }), compose(polynom<int>{ 1, 2, 3 }, polynom<int>{ 0, 1, 1 }, 3));
+    EXPECT_EQ((polynom<int>{ 1, 2, 5, 6, 3, 0, 0 }), compose(polynom<int>{ 1, 2, 3 }, polynom<int>{ 0, 1, 1 }, 7));
+    EXPECT_EQ((polynom<int>{ 17, 14, 3, 0 }), compose(polynom<int>{ 1, 2, 3 }, polynom<int>{ 2, 1 }, 4));
+    EXPECT_EQ((polynom<int>{ 17 }), compose(polynom<int>{ 1, 2, 3 }, polynom<int>{ 2, 1 }, 1));
+    EXPECT_EQ((polynom<int>{ 4, 0, 0 }), compose(polynom<int>{ 4 }, polynom<int>{ 2, 1 }, 3));
+    EXPECT_EQ((polynom<int>{ 2, 1, 0 }), compose(polynom<int>{ 0, 1 }, polynom<int>{ 2, 1 }, 3));
+    typedef modulo<int, 998244353, modulo_storage::CONSTANT> mod;
+    for (int k : { 1, 30, 500, 1500 }) {
+        for (int l : { 1, 20, 600 }) {
+            for (int n : { 1, 45, 1000 }) {
+                polynom<mod> f, g;
+                for (int i = 0; i <= k; i++) f[i] = mod(i * 12345 + 678);
+                for (int i = 0; i <= l; i++) g[i] = mod(i * 54321 + 876);
+                polynom<mod> e;
+                for (int i = k; i >= 0; i--) {
+                    polynom<mod>::mul(e, e, g, n - 1);
+                    e[0] += f[i];
+                }
+                e.resize(n);
+                EXPECT_EQ(e, compose(f, g, n)) << "k=" << k << " l=" << l << " n=" << n;
+            }
+        }
+    }
+    typedef series<mod, 3000> ser;
+    ser s;
+    for (int i = 1; i < 3000; i++) s[i] = mod(i * 12345 + 678);
+    EXPECT_EQ(s.exp(), compose(ser::exp(mod(1)), s));
+    EXPECT_EQ(s, compose(s, ser{ 0, 1 }));
+}
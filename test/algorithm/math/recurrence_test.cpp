@@ -25,6 +25,36 @@ TEST(recurrence_test, linear_recurrence) {
     EXPECT_EQ((vector<int> {2, 3, 5, 7, 11, 14, 18, 26, 41, 44, 42, 91, 173, 88, -37, 460, 1035, -509, -1787, 4361}), f);
 }
 
+TEST(recurrence_test, linear_recurrence_large) {
+    int L = polynom<mod>::newton_div_threshold() + 50;
+    std::vector<mod> f_coeff, f;
+    for (int i = 0; i < L; i++) f_coeff.push_back(mod(i * 7 + 3)), f.push_back(mod(i * 5 + 2));
+    for (int n = L; n <= 1000; n++) {
+        f.push_back(linear_recurrence_next<mod>(f_coeff, f));
+    }
+    for (int n : { 0, L - 1, L, L + 1, 500, 999, 1000 }) {
+        EXPECT_EQ(f[n], (linear_recurrence<mod, mod>(f_coeff, std::vector<mod>(f.begin(), f.begin() + L), n)));
+    }
+}
+
+TEST(recurrence_test, linear_recurrence_bostan_mori) {
+    std::vector<int> f;
+    for (int n = 0; n < 20; n++) {
+        f.push_back(linear_recurrence_bostan_mori<int>({1, -2, 3, 4, -5}, {2, 3, 5, 7, 11}, n));
+    }
+    EXPECT_EQ((vector<int> {2, 3, 5, 7, 11, 14, 18, 26, 41, 44, 42, 91, 173, 88, -37, 460, 1035, -509, -1787, 4361}), f);
+    EXPECT_EQ((vector<int> {4361, 2, 173, 11, 2}), linear_recurrence_bostan_mori<int>({1, -2, 3, 4, -5}, {2, 3, 5, 7, 11}, vector<int>{19, 0, 12, 4, 0}));
+    EXPECT_EQ(mod(fibonacci<mod>(1000000000000000000LL)), linear_recurrence_bostan_mori<mod>({ 1, 1 }, { 0, 1 }, 1000000000000000000LL));
+    int L = 300;
+    std::vector<mod> f_coeff, f_init;
+    for (int i = 0; i < L; i++) f_coeff.push_back(mod(i * 7 + 3)), f_init.push_back(mod(i * 5 + 2));
+    vector<ll> vn{ 0, 299, 300, 1000, 1000000000000000000LL, 123456789 };
+    vector<mod> vr;
+    for (ll n : vn) vr.push_back(linear_recurrence<mod, mod>(f_coeff, f_init, n));
+    EXPECT_EQ(vr, linear_recurrence_bostan_mori(f_coeff, f_init, vn));
+    EXPECT_EQ(vr[4], linear_recurrence_bostan_mori(f_coeff, f_init, vn[4]));
+}
+
 TEST(recurrence_test, linear_recurrence_next) {
     std::vector<int> f{ 2, 3, 5, 7, 11 };
     while (f.size() < 20) {
@@ -130,3 +160,23 @@ TEST(recurrence_test, berlekamp_massey) {
     }
     EXPECT_EQ(a[100], r);
 }
+
+TEST(recurrence_test, berlekamp_massey_large) {
+    int threshold = half_gcd_threshold();
+    for (int t : { 1, 4, 64 }) {
+        half_gcd_threshold() = t;
+        // a dense recurrence, and a sparse one, with the quotients of higher degree
+        for (int step : { 1, 7 }) {
+            int L = 300;
+            vector<mod> c(L, 0), a;
+            for (int i = 0; i < L; i += step) c[i] = mod(i * i + 3 * i + 1);
+            for (int i = 0; i < L; i++) a.push_back(mod(i * 7 + 2));
+            for (int n = L; n < L * 2; n++) a.push_back(linear_recurrence_next(c, a));
+            EXPECT_EQ(c, berlekamp_massey<mod>(a)) << "t=" << t << " step=" << step;
+        }
+    }
+    half_gcd_threshold() = threshold;
+    // fewer than two elements
+    EXPECT_EQ((polynom<mod>{ 1 }), berlekamp_massey_poly<mod>(vector<mod>{}));
+    EXPECT_EQ((polynom<mod>{ 1 }), berlekamp_massey_poly<mod>(vector<mod>{ 5 }));
+}
@@ -0,0 +1,34 @@
+﻿#include "altruct/concurrency/parallel.h"
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+using namespace std;
+using namespace altruct::concurrency;
+
+TEST(parallel_test, parallel_range) {
+    for (int t : { 1, 2, 3, 8 }) {
+        for (int n : { 0, 1, 5, 100 }) {
+            vector<int> v(n);
+            parallel_range(0, n, [&](int b, int e) {
+                for (int i = b; i < e; i++) v[i] += i * i;
+            }, t);
+            for (int i = 0; i < n; i++) EXPECT_EQ(i * i, v[i]) << "t=" << t << " n=" << n;
+        }
+    }
+}
+
+TEST(parallel_test, parallel_range_exception) {
+    for (int thrower : { 0, 1, 3 }) {
+        atomic<int> done(0);
+        EXPECT_THROW(parallel_range(0, 4, [&](int b, int e) {
+            if (b == thrower) throw runtime_error("chunk");
+            done++;
+        }, 4), runtime_error) << "thrower=" << thrower;
+        // the other chunks have completed
+        EXPECT_EQ(3, done.load()) << "thrower=" << thrower;
+    }
+}
@@ -176,6 +176,13 @@ TEST(matrix_test, power) {
         { { -164496, 1000000007 }, { 97240, 1000000007 }, { -22532, 1000000007 } } }) / modx(-78 * 78 * 78, 1000000007), m0.pow(-3));
 }
 
+TEST(matrix_test, power_montgomery) {
+    typedef modulo<int, 1000000007, modulo_storage::MONTGOMERY> modm;
+    const matrix<modm> m1({ { 2, 3, 5 }, { 7, 11, 13 }, { 17, 19, 23 } });
+    EXPECT_EQ((matrix<modm>{ { 3946, 4920, 6064 }, { 11456, 14278, 17588 }, { 20632, 25700, 31654 } }), m1.pow(3));
+    EXPECT_EQ((matrix<modm>{ { -55788, 107120, -48832 }, { 247392, -205764, 66936 }, { -164496, 97240, -22532 } }) / modm(-78 * 78 * 78), m1.pow(-3));
+}
+
 TEST(matrix_test, transpose) {
     const matrix<int> m1({ { 1, 2, 3 }, { 4, 5, 6 } });
     EXPECT_EQ((matrix<int>{ { 1, 4 }, { 2, 5 }, { 3, 6 }}), m1.transpose());
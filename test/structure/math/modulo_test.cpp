@@ -155,6 +155,169 @@ TEST(modulo_test, int64) {
     EXPECT_EQ(modl(250000000000000001LL), m1 / m4);
 }
 
+TEST(modulo_test, mul_wide) {
+    uint32_t h32;
+    EXPECT_EQ(0x00000001u, mul_wide(0xFFFFFFFFu, 0xFFFFFFFFu, &h32));
+    EXPECT_EQ(0xFFFFFFFEu, h32);
+    uint64_t h64;
+    EXPECT_EQ(0x0000000000000001ull, mul_wide(0xFFFFFFFFFFFFFFFFull, 0xFFFFFFFFFFFFFFFFull, &h64));
+    EXPECT_EQ(0xFFFFFFFFFFFFFFFEull, h64);
+    EXPECT_EQ(0x2236D88FE5618CF0ull, mul_wide(0x0123456789ABCDEFull, 0xFEDCBA9876543210ull, &h64));
+    EXPECT_EQ(0x0121FA00AD77D742ull, h64);
+}
+
+TEST(modulo_test, montgomery) {
+    typedef modulo<int, 1000000007, modulo_storage::MONTGOMERY> modm;
+    EXPECT_EQ(1000000007, modm::M());
+    const modm m1(1000000000);
+    const modm m2(2000000023);
+    const modm m3(-6);
+    EXPECT_EQ(1000000000, m1.v);
+    EXPECT_EQ(9, m2.v);
+    EXPECT_EQ(1000000001, m3.v);
+    EXPECT_EQ(modm(-7), m1);
+    EXPECT_EQ(modm(2), m1 + m2);
+    EXPECT_EQ(modm(-16), m1 - m2);
+    EXPECT_EQ(modm(7), -m1);
+    EXPECT_EQ(modm(0), -modm(0));
+    EXPECT_EQ(modm(-63), m1 * m2);
+    EXPECT_EQ(modm(222222223), m1 / m2);
+    EXPECT_EQ(modm(1), m1 % m2);
+    EXPECT_EQ(modm(714285718), m2 / m1);
+    EXPECT_EQ(modm(1), m1 * m1.inv());
+    ASSERT_COMPARISON_OPERATORS(0, m1, m1);
+    ASSERT_COMPARISON_OPERATORS(-1, m2, m1);
+    ASSERT_COMPARISON_OPERATORS(+1, m1, m2);
+    modm mr = m1;
+    mr.v = 5;
+    EXPECT_EQ(5, mr.v);
+    mr *= m2; mr -= m1; mr += m2;
+    EXPECT_EQ(61, mr.v);
+    EXPECT_EQ(0, zeroT<modm>::of(m1).v);
+    EXPECT_EQ(1, identityT<modm>::of(m1).v);
+    EXPECT_EQ(282475249, powT(m1, 10).v);
+    EXPECT_EQ(1000000004, castOf<modm>(-3).v);
+    EXPECT_EQ(1000000002, castOf(m1, -5).v);
+    EXPECT_EQ(1000000002, castOf<modm>(modm(-5)).v);
+}
+
+TEST(modulo_test, montgomery_int64) {
+    typedef modulo<int64_t, 1, modulo_storage::MONTGOMERY> modml;
+    modml::set_M(1000000000000000003LL);
+    const modml m1(1000000000000000000LL);
+    const modml m2(2000000000000000008LL);
+    const modml m4(4000000000000000000LL);
+    EXPECT_EQ(1000000000000000003LL, modml::M());
+    EXPECT_EQ(1000000000000000000LL, m1.v);
+    EXPECT_EQ(modml(-3), m1);
+    EXPECT_EQ(modml(2), m2);
+    EXPECT_EQ(modml(-12), m4);
+    EXPECT_EQ(modml(-1), m1 + m2);
+    EXPECT_EQ(modml(-5), m1 - m2);
+    EXPECT_EQ(modml(3), -m1);
+    EXPECT_EQ(modml(-6), m1 * m2);
+    EXPECT_EQ(modml(9), m1 * m1);
+    EXPECT_EQ(modml(500000000000000000LL), m1 / m2);
+    EXPECT_EQ(modml(666666666666666668LL), m2 / m1);
+    EXPECT_EQ(modml(250000000000000001LL), m1 / m4);
+    EXPECT_EQ(modml(1), m4 * m4.inv());
+    modml::set_M(4611686018427387847LL); // largest prime below 2^62
+    EXPECT_EQ(modml(4611686018427387846LL), modml(-1));
+    EXPECT_EQ(modml(1), modml(-1) * modml(-1));
+    EXPECT_EQ(modml(4), powT(modml(2), 4611686018427387847LL + 1));
+}
+
+TEST(modulo_test, modulo_mul_int64) {
+    const int64_t M = 1000000000000000003LL;
+    EXPECT_EQ(9, modulo_mul(M - 3, M - 3, M));
+    EXPECT_EQ(M - 6, modulo_mul(M - 3, int64_t(2), M));
+    EXPECT_EQ(1, modulo_mul(int64_t(0x7FFFFFFFFFFFFFFELL), int64_t(0x7FFFFFFFFFFFFFFELL), int64_t(0x7FFFFFFFFFFFFFFFLL)));
+    EXPECT_EQ(-9, modulo_mul(3 - M, M - 3, M));
+    EXPECT_EQ(9, modulo_mul(3 - M, 3 - M, M));
+    EXPECT_EQ(modulo_mul(M - 3, M - 3, M), modulo_mul(M * 2 - 3, M * 3 - 3, M));
+    uint64_t r;
+    EXPECT_EQ(uint64_t(6148914691236517205ull), div_wide(1, 0, 3, &r));
+    EXPECT_EQ(uint64_t(1), r);
+    EXPECT_EQ(0xFFFFFFFFFFFFFFFFull, div_wide(0x0000000000000002ull, 0xFFFFFFFFFFFFFFFDull, 0x0000000000000003ull, &r));
+    EXPECT_EQ(0ull, r);
+}
+
+TEST(modulo_test, barrett) {
+    for (uint32_t M : { 1u, 2u, 3u, 1000000007u, 998244353u, (1u << 30) - 35 }) {
+        barrett<uint32_t> br(M);
+        for (uint32_t x : { 0u, 1u, 2u, M / 2, M - 2, M - 1 }) {
+            for (uint32_t y : { 0u, 1u, 3u, M / 3, M - 1 }) {
+                if (x >= M || y >= M) continue;
+                EXPECT_EQ(uint32_t(uint64_t(x) * y % M), br.mul(x, y)) << M << " " << x << " " << y;
+            }
+        }
+    }
+    for (uint64_t M : std::vector<uint64_t>{ 1, 2, 1000000007, 1000000000000000003ull, (1ull << 62) - 57 }) {
+        barrett<uint64_t> br(M);
+        for (uint64_t x : std::vector<uint64_t>{ 0, 1, 2, M / 2, M - 2, M - 1 }) {
+            for (uint64_t y : std::vector<uint64_t>{ 0, 1, 3, M / 3, M - 1 }) {
+                if (x >= M || y >= M) continue;
+                EXPECT_EQ(uint64_t(modulo_mul(int64_t(x), int64_t(y), int64_t(M))), br.mul(x, y)) << M << " " << x << " " << y;
+            }
+        }
+    }
+    // reducer falls back to `modulo_mul` for moduli of 2^(w-2) and above
+    EXPECT_EQ(9, modulo_reducer<int32_t>(2147483647).mul(2147483644, 2147483644, 2147483647));
+    EXPECT_EQ(9, modulo_reducer<int64_t>(int64_t(0x7FFFFFFFFFFFFFFFLL)).mul(int64_t(0x7FFFFFFFFFFFFFFCLL), int64_t(0x7FFFFFFFFFFFFFFCLL), int64_t(0x7FFFFFFFFFFFFFFFLL)));
+    // as well as denormalized operands
+    EXPECT_EQ(-221, modulo_reducer<int32_t>(289).mul(-272, 4, 289));
+    EXPECT_EQ(-221, modulo_reducer<int64_t>(289).mul(-272, 4, 289));
+    // and a context for another modulus
+    EXPECT_FALSE(modulo_reducer<int32_t>(289).is_for(17));
+    EXPECT_EQ(13, modulo_reducer<int32_t>(289).mul(5, 6, 17));
+    EXPECT_TRUE(modulo_reducer<int32_t>(2147483647).is_for(2147483646));
+}
+
+TEST(modulo_test, reducer_members) {
+    // alternating moduli
+    typedef moduloX<int> modx;
+    modx a(1000000000, 1000000007), b(1000000000, 998244353);
+    EXPECT_EQ(49, (a * a).v);
+    EXPECT_EQ(modx(1755647 * 1755647LL % 998244353, 998244353).v, (b * b).v);
+    EXPECT_EQ(49, (a * a).v);
+    EXPECT_EQ(sizeof(int) * 2, sizeof(modx));
+    // changing the static modulus
+    typedef modulo<int, 3> mods;
+    mods::M() = 1000000007;
+    EXPECT_FALSE(mods::_reducer.is_for(1000000007));
+    EXPECT_EQ(49, (mods(1000000000) * mods(1000000000)).v);
+    EXPECT_FALSE(mods::_reducer.is_for(1000000007));
+    mods::set_M(998244353);
+    EXPECT_TRUE(mods::_reducer.is_for(998244353));
+    EXPECT_EQ((b * b).v, (mods(1000000000) * mods(1000000000)).v);
+    mods::set_M(1000000007);
+    EXPECT_EQ(49, (mods(1000000000) * mods(1000000000)).v);
+}
+
+TEST(modulo_test, reduced_power) {
+    typedef moduloX<int> modx;
+    typedef moduloX<int64_t> modxl;
+    typedef modulo<int64_t, 3> modsl;
+    for (int M : { 1, 2, 17, 998244353, 1000000007, 2147483647 }) {
+        modx x(123456789, M), r(1, M);
+        for (int k = 0; k <= 40; k++) {
+            EXPECT_EQ(r, powT(x, k)) << M << " " << k;
+            r *= x;
+        }
+    }
+    for (int64_t M : { int64_t(1000000007), int64_t(1000000000000000003LL), int64_t(0x7FFFFFFFFFFFFFFFLL) }) {
+        modxl x(int64_t(123456789123456789LL), M), r(1, M);
+        modsl::M() = M;
+        modsl xs(int64_t(123456789123456789LL)), rs(1);
+        for (int k = 0; k <= 40; k++) {
+            EXPECT_EQ(r, powT(x, k)) << M << " " << k;
+            EXPECT_EQ(rs, powT(xs, k)) << M << " " << k;
+            r *= x, rs *= xs;
+        }
+    }
+    EXPECT_EQ(1, modulo_power(3, 1000000006, 1000000007));
+}
+
 template<typename T, typename F>
 void modulo_test_perf_impl(T a, T b, int n, const char *msg, const F& func) {
     double clocks_per_sec = 1000;
@@ -204,6 +367,21 @@ TEST(modulo_test, perf) {
     modulo_test_perf_impl(aml, bml, nml, "mod<ll> add", [](modl &a, modl &b){a += b; b.v++; });
     modulo_test_perf_impl(aml, bml, nml, "mod<ll> sub", [](modl &a, modl &b){a -= b; b.v++; });
     modulo_test_perf_impl(aml, bml, nml, "mod<ll> neg", [](modl &a, modl &b){a = -b; b.v++; });
-    modulo_test_perf_impl(aml, bml, nml / 100, "mod<ll> mul", [](modl &a, modl &b){a *= b; b.v++; });
+    modulo_test_perf_impl(aml, bml, nml / 3, "mod<ll> mul", [](modl &a, modl &b){a *= b; b.v++; });
     modulo_test_perf_impl(aml, bml, nml / 300, "mod<ll> div", [](modl &a, modl &b){a /= b; a.v++; });
+
+    typedef modulo<int, 1000000007, modulo_storage::MONTGOMERY> modm;
+    modm amm(12345678);
+    modm bmm(13456789);
+    modulo_test_perf_impl(amm, bmm, nmi, "modm<int> add", [](modm &a, modm &b){a += b; b.v.r++; });
+    modulo_test_perf_impl(amm, bmm, nmi, "modm<int> sub", [](modm &a, modm &b){a -= b; b.v.r++; });
+    modulo_test_perf_impl(amm, bmm, nmi / 3, "modm<int> mul", [](modm &a, modm &b){a *= b; b.v.r++; });
+
+    typedef modulo<int64_t, 1, modulo_storage::MONTGOMERY> modml;
+    modml::set_M(1000000000000000003LL);
+    modml aml2(12345678);
+    modml bml2(13456789);
+    modulo_test_perf_impl(aml2, bml2, nml, "modm<ll> add", [](modml &a, modml &b){a += b; b.v.r++; });
+    modulo_test_perf_impl(aml2, bml2, nml, "modm<ll> sub", [](modml &a, modml &b){a -= b; b.v.r++; });
+    modulo_test_perf_impl(aml2, bml2, nml / 3, "modm<ll> mul", [](modml &a, modml &b){a *= b; b.v.r++; });
 }
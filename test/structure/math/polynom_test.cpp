@@ -3,6 +3,8 @@
 #include "altruct/structure/math/modulo.h"
 #include "structure_test_util.h"
 
+#include <thread>
+
 #include "gtest/gtest.h"
 
 using namespace std;
@@ -104,6 +106,34 @@ TEST(polynom_test, shrink_to_fit) {
     EXPECT_EQ((vector<int>{ 1, 2, 3, 4 }), p.c);
 }
 
+TEST(polynom_test, normalize) {
+    polynom<int> p{ 1, 2, 3, 4, 0, 0 };
+    EXPECT_FALSE(p.is_normalized());
+    p.normalize();
+    EXPECT_TRUE(p.is_normalized());
+    EXPECT_EQ((vector<int>{ 1, 2, 3, 4 }), p.c);
+    polynom<int> p0{ 0, 0 };
+    p0.normalize();
+    EXPECT_EQ((vector<int>{ 0 }), p0.c);
+    polynom<int> pe(vector<int>{});
+    pe.normalize();
+    EXPECT_EQ((vector<int>{}), pe.c);
+    EXPECT_TRUE(pe.is_normalized());
+}
+
+TEST(polynom_test, normalized_results) {
+    const polynom<int> p1{ 1, 2, 3, 4 };
+    const polynom<int> p2{ 5, 6, 7, 4 };
+    EXPECT_EQ((vector<int>{ -4, -4, -4 }), (p1 - p2).c);
+    EXPECT_EQ((vector<int>{ 0 }), (p1 - p1).c);
+    EXPECT_EQ((vector<int>{ 6, 8, 10, 8 }), (p1 + p2).c);
+    EXPECT_EQ((vector<int>{ 0 }), (p1 * 0).c);
+    EXPECT_EQ((vector<int>{ -4, -4, -4 }), (p1 % p2).c);
+    EXPECT_EQ((vector<int>{ 1 }), (p1 / p2).c);
+    EXPECT_EQ((vector<int>{ 0 }), (polynom<int>{ 2, 4, 6, 8 } % p1).c);
+    EXPECT_TRUE((polynom<int>{ 3, 4, 2 } % polynom<int>{ 1, 1 }).is_normalized());
+}
+
 TEST(polynom_test, reserve) {
     polynom<int> p{ 1, 2, 3, 4 };
     EXPECT_EQ(4, p.c.size());
@@ -408,6 +438,65 @@ TEST(polynom_test, mul_size) {
     EXPECT_EQ(q11_150, q_fft_inplace_150);
 }
 
+TEST(polynom_test, mul_scratch) {
+    // run on a fresh thread, so that the thread local scratch space is empty
+    std::thread([]() {
+        auto& ws = polynom_scratch<long long>::local();
+        polynom<long long> p1; for (int l = 1000; l >= 0; l--) p1[l] = l * 7 % 13 - 6;
+        polynom<long long> p2; for (int l = 700; l >= 0; l--) p2[l] = l * 5 % 11 - 5;
+        polynom<long long> q_long; do_mul(polynom<long long>::_mul_long, q_long, p1, p2);
+        polynom<long long> q_kar; do_mul(polynom<long long>::_mul_karatsuba, q_kar, p1, p2);
+        EXPECT_EQ(q_long, q_kar);
+        EXPECT_EQ(1, ws.allocations);
+        polynom<long long> q12 = p1 * p2;
+        EXPECT_EQ(q_long, q12);
+        polynom<long long> q_kar_inplace = p1; do_mul(polynom<long long>::_mul_karatsuba, q_kar_inplace, q_kar_inplace, p2, 1200);
+        EXPECT_EQ(polynom<long long>(q_long.c.begin(), q_long.c.begin() + 1201), q_kar_inplace);
+        EXPECT_EQ(1, ws.allocations);
+        ws.clear();
+        EXPECT_EQ(0, ws.capacity());
+    }).join();
+}
+
+TEST(polynom_test, mul_operand) {
+    const polynom<int> p2{ 1, -3, 5, 7 };
+    const polynom<int> p3{ 2, 3, 5, -7, 0, 0 };
+    const polynom_operand<int> o3(p3);
+    polynom<int> pr;
+    polynom<int>::mul(pr, p2, o3);
+    EXPECT_EQ((polynom<int>{ 2, -3, 6, 7, 67, 0, -49 }), pr);
+    polynom<int>::mul(pr, p2, o3, 3);
+    EXPECT_EQ((polynom<int>{ 2, -3, 6, 7 }), pr);
+    // inplace
+    pr = p2;
+    polynom<int>::mul(pr, pr, o3);
+    EXPECT_EQ((polynom<int>{ 2, -3, 6, 7, 67, 0, -49 }), pr);
+}
+
+TEST(polynom_test, mul_middle) {
+    const polynom<int> p0{};
+    const polynom<int> p2{ 1, -3, 5, 7 };
+    const polynom<int> p3{ 2, 3, 5, -7, 0, 0 };
+    polynom<int> pr;
+    polynom<int>::mul_middle(pr, p2, p3, 2, 4);
+    EXPECT_EQ((polynom<int>{ 6, 7, 67 }), pr);
+    polynom<int>::mul_middle(pr, p2, p3, 0, 6);
+    EXPECT_EQ((polynom<int>{ 2, -3, 6, 7, 67, 0, -49 }), pr);
+    polynom<int>::mul_middle(pr, p2, p3, 5, 8);
+    EXPECT_EQ((polynom<int>{ 0, -49, 0, 0 }), pr);
+    EXPECT_EQ(4, pr.size());
+    polynom<int>::mul_middle(pr, p2, p3, 7, 8);
+    EXPECT_EQ((polynom<int>{ 0, 0 }), pr);
+    polynom<int>::mul_middle(pr, p0, p3, 1, 2);
+    EXPECT_EQ((polynom<int>{ 0, 0 }), pr);
+    polynom<int>::mul_middle(pr, p2, polynom_operand<int>(p3), 3, 4);
+    EXPECT_EQ((polynom<int>{ 7, 67 }), pr);
+    // inplace
+    pr = p2;
+    polynom<int>::mul_middle(pr, pr, p3, 1, 3);
+    EXPECT_EQ((polynom<int>{ -3, 6, 7 }), pr);
+}
+
 TEST(polynom_test, quot_rem) {
     const polynom<int> p0{};
     const polynom<int> p1{ 6 };
@@ -440,6 +529,94 @@ TEST(polynom_test, quot_rem) {
     EXPECT_EQ((polynom<int>{ 0, 0, 0, 0, 0, 0, 1 }), pr);
 }
 
+TEST(polynom_test, quot_rem_newton) {
+    polynom<int> p1, p2;
+    for (int i = 0; i < 40; i++) p1[i] = (i * 7 + 3) % 11 - 5;
+    for (int i = 0; i < 15; i++) p2[i] = (i * 5 + 2) % 7 - 3;
+    p2[15] = 1;
+    polynom<int> e, pr;
+    polynom<int>::quot_rem(e, p1, p2);
+    int threshold = polynom<int>::newton_div_threshold();
+    polynom<int>::newton_div_threshold() = 1;
+    polynom<int>::quot_rem(pr, p1, p2);
+    EXPECT_EQ(e, pr);
+    // inplace
+    pr = p1;
+    polynom<int>::quot_rem(pr, pr, p2);
+    EXPECT_EQ(e, pr);
+    // quotient longer than divisor
+    const polynom<int> p3{ 2, 1, -1, 3, 1 };
+    EXPECT_EQ(p1, p1 / p3 * p3 + p1 % p3);
+    EXPECT_EQ(4, (p1 % p3).size());
+    polynom<int>::newton_div_threshold() = threshold;
+}
+
+TEST(polynom_test, divisor) {
+    polynom<int> p1, p2;
+    for (int i = 0; i < 40; i++) p1[i] = (i * 7 + 3) % 11 - 5;
+    for (int i = 0; i < 15; i++) p2[i] = (i * 5 + 2) % 7 - 3;
+    p2[15] = 1;
+    polynom<int> e, pr;
+    polynom<int>::quot_rem(e, p1, p2);
+    int threshold = polynom<int>::newton_div_threshold();
+    polynom<int>::newton_div_threshold() = 1;
+    const polynom_divisor<int> d2(p2, 40);
+    EXPECT_TRUE(d2.newton);
+    polynom<int>::quot_rem(pr, p1, d2);
+    EXPECT_EQ(e, pr);
+    // inplace
+    pr = p1;
+    polynom<int>::quot_rem(pr, pr, d2);
+    EXPECT_EQ(e, pr);
+    polynom<int>::mod(pr, p1, d2);
+    EXPECT_EQ(p1 % p2, pr);
+    // dividends of a higher degree than prepared for
+    const polynom_divisor<int> d3(p2);
+    EXPECT_EQ(28, d3.l1);
+    polynom<int>::mod(pr, p1, d3);
+    EXPECT_EQ(p1 % p2, pr);
+    polynom<int>::mod(pr, p2 * p2, d3);
+    EXPECT_EQ(polynom<int>{ 0 }, pr);
+    polynom<int>::newton_div_threshold() = threshold;
+    const polynom_divisor<int> d4(p2, 40);
+    EXPECT_FALSE(d4.newton);
+    polynom<int>::mod(pr, p1, d4);
+    EXPECT_EQ(p1 % p2, pr);
+}
+
+TEST(polynom_test, inverse) {
+    polynom<int> pr;
+    polynom<int>::inverse(pr, polynom<int>{ 1, -3, 5, 7 }, 4);
+    EXPECT_EQ((polynom<int>{ 1, 3, 4, -10 }), pr);
+    polynom<int>::inverse(pr, polynom<int>{ 1, -3, 5, 7 }, 1);
+    EXPECT_EQ((polynom<int>{ 1 }), pr);
+    polynom<int>::inverse(pr, polynom<int>{ 1, 1 }, 6);
+    EXPECT_EQ((polynom<int>{ 1, -1, 1, -1, 1, -1 }), pr);
+    EXPECT_EQ(6, pr.size());
+    // inplace
+    pr = { 1, -3, 5, 7 };
+    polynom<int>::inverse(pr, pr, 4);
+    EXPECT_EQ((polynom<int>{ 1, 3, 4, -10 }), pr);
+}
+
+TEST(polynom_test, divide) {
+    polynom<int> pr;
+    polynom<int>::divide(pr, polynom<int>{ 2, 1 }, polynom<int>{ 1, -3, 5, 7 }, 5);
+    EXPECT_EQ((polynom<int>{ 2, 7, 11, -16, -152 }), pr);
+    polynom<int>::divide(pr, polynom<int>{ 2, 1 }, polynom<int>{ 1, -3, 5, 7 }, 4);
+    EXPECT_EQ((polynom<int>{ 2, 7, 11, -16 }), pr);
+    polynom<int>::divide(pr, polynom<int>{ 2, 1 }, polynom<int>{ 1, -3, 5, 7 }, 1);
+    EXPECT_EQ((polynom<int>{ 2 }), pr);
+    EXPECT_EQ(1, pr.size());
+    // inplace
+    pr = { 1, -3, 5, 7 };
+    polynom<int>::divide(pr, polynom<int>{ 2, 1 }, pr, 5);
+    EXPECT_EQ((polynom<int>{ 2, 7, 11, -16, -152 }), pr);
+    pr = { 2, 1 };
+    polynom<int>::divide(pr, pr, polynom<int>{ 1, -3, 5, 7 }, 5);
+    EXPECT_EQ((polynom<int>{ 2, 7, 11, -16, -152 }), pr);
+}
+
 TEST(polynom_test, div) {
     const polynom<int> p0{};
     const polynom<int> p1{ 6 };
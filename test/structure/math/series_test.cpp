@@ -176,6 +176,23 @@ TEST(series_test, shift) {
     EXPECT_EQ((series<int, 7>{ 4, 2, 1, -8, 0, 0, 0 }), s.shift(-3));
 }
 
+TEST(series_test, shift_after_cancellation) {
+    seriesX<double> c({ 1, 2, 3, 4 });
+    c *= 0.0;
+    EXPECT_EQ(4, c.size());
+    EXPECT_EQ((seriesX<double>{ 0, 0, 0, 0 }), c.shift(2));
+    seriesX<double> a({ 1, 2, 3, 4 });
+    a -= a;
+    EXPECT_EQ(4, a.size());
+    EXPECT_EQ((seriesX<double>{ 0, 0, 0, 0 }), a.shift(-1));
+    seriesX<double> b({ 1, 2, 3, 4 });
+    b += seriesX<double>({ 0, 0, -3, -4 });
+    EXPECT_EQ(4, b.size());
+    EXPECT_EQ((seriesX<double>{ 0, 1, 2, 0 }), b.shift(1));
+    b /= 2.0;
+    EXPECT_EQ((seriesX<double>{ 0, 0, 0.5, 1 }), b.shift(2));
+}
+
 TEST(series_test, sub_mul) {
     const series<int, 4> s{ 7, 5, -3, 4 };
     EXPECT_EQ((series<int, 4>{ 7, -15, -27, -108 }), s.sub_mul(-3));
@@ -208,6 +225,31 @@ TEST(series_test, ln) {
     EXPECT_EQ((series<double, 5>{ 5, -36, 6, 156, 399 }), s1.ln(5));
 }
 
+TEST(series_test, sqrt) {
+    const series<double, 5> s1{ 1, 4, 10, 12, 9 };
+    EXPECT_EQ((series<double, 5>{ 1, 2, 3, 0, 0 }), s1.sqrt());
+    const series<double, 5> s2{ 4, 16, 40, 48, 36 };
+    EXPECT_EQ((series<double, 5>{ -2, -4, -6, 0, 0 }), s2.sqrt(-2));
+    const series<double, 5> s3{ 0, 0, 1, 4, 10 };
+    auto r3 = s3.sqrt();
+    // the top coefficient depends on s3[5], and is left zero
+    EXPECT_EQ((series<double, 5>{ 0, 1, 2, 3, 0 }), r3);
+    EXPECT_EQ(s3, r3 * r3);
+    const series<double, 5> s4{ 0, 0, 0, 0, 1 };
+    EXPECT_EQ((series<double, 5>{ 0, 0, 1, 0, 0 }), s4.sqrt());
+    const series<double, 5> s5{ 0, 1, 2, 3, 4 };
+    EXPECT_THROW(s5.sqrt(), std::domain_error);
+    const series<double, 5> s0{ 0, 0, 0, 0, 0 };
+    EXPECT_EQ(s0, s0.sqrt());
+}
+
+TEST(series_test, inverse_sqrt) {
+    const series<double, 5> s1{ 1, 4, 10, 12, 9 };
+    EXPECT_EQ((series<double, 5>{ 1, -2, 1, 4, -11 }), s1.inverse_sqrt());
+    const series<double, 5> s2{ 4, 16, 40, 48, 36 };
+    EXPECT_EQ((series<double, 5>{ 0.5, -1, 0.5, 2, -5.5 }), s2.inverse_sqrt(0.5));
+}
+
 TEST(series_test, pow) {
     const series<double, 10> s1{ 1, 2, 3, 5, 7, 11, 13, 17, 19, 23 };
     EXPECT_EQ((series<double, 10>{1, 6, 21, 59, 144, 321, 663, 1284, 2358, 4133}), s1.pow(3, 0));
@@ -0,0 +1,114 @@
+﻿#include "altruct/structure/math/small_polynom.h"
+#include "altruct/structure/math/polynom.h"
+#include "altruct/structure/math/modulo.h"
+#include "altruct/algorithm/math/recurrence.h"
+
+#include "gtest/gtest.h"
+
+using namespace std;
+using namespace altruct::math;
+
+namespace {
+typedef modulo<int, 1000000007> mod;
+typedef small_polynom<int, 4> spoly4;
+typedef small_polynom<mod, 8> spoly8;
+}
+
+TEST(small_polynom_test, constructor) {
+    spoly4 p0;
+    EXPECT_EQ((array<int, 4>{{ 0, 0, 0, 0 }}), p0.c);
+    spoly4 p1(5);
+    EXPECT_EQ((array<int, 4>{{ 5, 0, 0, 0 }}), p1.c);
+    spoly4 p2{ 1, 2, 3 };
+    EXPECT_EQ((array<int, 4>{{ 1, 2, 3, 0 }}), p2.c);
+    vector<int> v{ 1, 2, 3, 4, 5 };
+    spoly4 p3(v.begin(), v.end());
+    EXPECT_EQ((array<int, 4>{{ 1, 2, 3, 4 }}), p3.c);
+    spoly4 p4(polynom<int>{ 7, 0, 9 });
+    EXPECT_EQ((array<int, 4>{{ 7, 0, 9, 0 }}), p4.c);
+    EXPECT_EQ((polynom<int>{ 7, 0, 9 }), p4.to_polynom());
+    small_polynom<mod, 3> q1(1);
+    EXPECT_EQ((array<mod, 3>{{ 1, 0, 0 }}), q1.c);
+    EXPECT_EQ(4, p0.size());
+}
+
+TEST(small_polynom_test, degree) {
+    EXPECT_EQ(0, spoly4().deg());
+    EXPECT_EQ(0, spoly4(5).deg());
+    EXPECT_EQ(2, (spoly4{ 1, 2, 3 }).deg());
+    EXPECT_EQ(3, (spoly4{ 0, 0, 0, 4 }).deg());
+    EXPECT_EQ(3, (spoly4{ 1, 2, 3 }).leading_coeff());
+}
+
+TEST(small_polynom_test, operators_comparison) {
+    spoly4 p1{ 1, 2, 3 }, p2{ 1, 2, 4 }, p3{ 2, 2, 3 };
+    EXPECT_TRUE(p1 == spoly4({ 1, 2, 3 }));
+    EXPECT_TRUE(p1 != p2);
+    EXPECT_TRUE(p1 < p2);
+    EXPECT_TRUE(p1 < p3);
+    EXPECT_TRUE(p3 < p2);
+    EXPECT_TRUE(p2 > p3);
+    EXPECT_TRUE(p1 <= p1);
+    EXPECT_TRUE(p1 >= p1);
+}
+
+TEST(small_polynom_test, operators_arithmetic) {
+    const spoly4 p1{ 1, 2, 3 }, p2{ 5, -1 };
+    EXPECT_EQ((spoly4{ 6, 1, 3 }), p1 + p2);
+    EXPECT_EQ((spoly4{ -4, 3, 3 }), p1 - p2);
+    EXPECT_EQ((spoly4{ -1, -2, -3 }), -p1);
+    EXPECT_EQ((spoly4{ 5, 9, 13, -3 }), p1 * p2);
+    EXPECT_EQ((spoly4{ 2, 4, 6 }), p1 * 2);
+    EXPECT_EQ((spoly4{ 0, 1, 1 }), (spoly4{ 0, 3, 3 } / 3));
+    // truncated to `x^4`
+    EXPECT_EQ((spoly4{ 1, 4, 10, 12 }), p1 * p1);
+    // quotient and remainder
+    const spoly4 p3{ 5, 9, 13, -3 };
+    EXPECT_EQ(p1, p3 / p2);
+    EXPECT_EQ(spoly4(), p3 % p2);
+    EXPECT_EQ((spoly4{ 6 }), (p3 + spoly4{ 1, 1 }) % p2);
+    EXPECT_EQ((spoly4{ 6, 10 }), (p3 + spoly4{ 1, 1 }) % (spoly4{ 0, 0, 1 }));
+    EXPECT_EQ(spoly4(), p2 / p1);
+    EXPECT_EQ(p2, p2 % p1);
+    const small_polynom<mod, 4> q1{ 1, 2, 3 }, q2{ 2, 4 };
+    EXPECT_EQ((small_polynom<mod, 4>{ mod(1) / 8, mod(3) / 4 }), (q1 / q2));
+    EXPECT_EQ((small_polynom<mod, 4>{ mod(3) / 4 }), (q1 % q2));
+}
+
+TEST(small_polynom_test, mul_mod) {
+    const spoly8 p1{ 1, 2, 3, 4, 5, 6, 7 }, p2{ 7, 6, 5, 4, 3, 2, 1 }, pm{ 3, 0, 1, 4, 0, 0, 1 };
+    polynom<mod> e = p1.to_polynom() * p2.to_polynom() % pm.to_polynom();
+    EXPECT_EQ(e, spoly8::mul_mod(p1, p2, pm).to_polynom());
+    EXPECT_EQ(e, modulo_mul(p1, p2, pm).to_polynom());
+}
+
+TEST(small_polynom_test, eval) {
+    const spoly4 p{ 1, 2, 3 };
+    EXPECT_EQ(1, p(0));
+    EXPECT_EQ(6, p(1));
+    EXPECT_EQ(17, p(2));
+    EXPECT_EQ(6.0, p(1.0));
+}
+
+TEST(small_polynom_test, moduloX) {
+    // x^n mod p(x), the same as by `powx_mod`
+    const polynom<mod> p{ 3, 5, 0, 7, 2, 0, 1 };
+    typedef moduloX<spoly8> polymod;
+    for (int n : { 0, 1, 5, 6, 7, 100, 12345 }) {
+        polymod r = powT(polymod(spoly8{ 0, 1 }, spoly8(p)), n);
+        EXPECT_EQ(powx_mod(p, n), r.v.to_polynom()) << "n=" << n;
+    }
+    // fibonacci
+    typedef moduloX<small_polynom<mod, 3>> fibmod;
+    fibmod x(small_polynom<mod, 3>{ 0, 1 }, small_polynom<mod, 3>{ -1, -1, 1 });
+    EXPECT_EQ(mod(687995182), powT(x, 100).v[1]);
+}
+
+TEST(small_polynom_test, casts) {
+    const spoly4 p{ 1, 2, 3 };
+    EXPECT_EQ(spoly4(1), identityOf(p));
+    EXPECT_EQ(spoly4(0), zeroOf(p));
+    EXPECT_EQ(spoly4(5), castOf<spoly4>(5));
+    EXPECT_EQ(spoly4(5), castOf(p, 5));
+    EXPECT_EQ(p, castOf<spoly4>(p));
+}